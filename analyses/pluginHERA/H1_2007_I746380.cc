@@ -258,13 +258,8 @@ namespace H1_2007_I746380_PROJECTIONS {
         _boost = LorentzTransform::mkFrameTransformFromBeta(pX.betaVec());
 
       // Boost the particles from system X.
-      _theParticles.clear();
-      _theParticles.reserve(rg.systemX(RapidityGap::HCM).size());
-      for (const Particle& p : rg.systemX(RapidityGap::HCM)) {
-        Particle temp = p;
-        temp.setMomentum(_boost.transform(temp.momentum()));
-        _theParticles.push_back(temp);
-      }
+      _theParticles = rg.systemX(RapidityGap::HCM);
+      transformBy(_theParticles, _boost);
 
     }
 
@@ -66,6 +66,9 @@ namespace Rivet {
     /// The AnalysisHandler is a friend.
     friend class AnalysisHandler;
 
+    /// Percentiles register their calibration journals.
+    friend class PercentileBase;
+
 
   public:
 
@@ -330,6 +333,11 @@ namespace Rivet {
     /// Access the controlling AnalysisHandler object.
     AnalysisHandler& handler() const { return *_analysishandler; }
 
+    /// @brief State of this analysis which a checkpoint of the run cannot save.
+    ///
+    /// Empty unless declared with declareUncheckpointed().
+    const string& uncheckpointed() const { return _uncheckpointed; }
+
 
   protected:
 
@@ -360,6 +368,13 @@ namespace Rivet {
     /// @note Use in the finalize phase only.
     double sumW2() const;
 
+    /// @brief Declare state, described by @a what, which is kept outside the
+    /// analysis objects, eg. running sums or pools of events.
+    ///
+    /// A checkpoint of the run cannot save it, so a run including this
+    /// analysis cannot be resumed from a checkpoint.
+    void declareUncheckpointed(const string& what) { _uncheckpointed = what; }
+
 
   protected:
 
@@ -388,7 +403,7 @@ namespace Rivet {
     /// @todo SFINAE to ensure that the type inherits from YODA::AnalysisObject?
     template <typename T=YODA::Scatter2D>
     const T& refData(const string& hname) const {
-      _cacheRefData();
+      _cacheRefData(hname);
       MSG_TRACE("Using histo bin edges for " << name() << ":" << hname);
       if (!_refdata[hname]) {
         MSG_ERROR("Can't find reference histogram " << hname);
@@ -773,6 +788,9 @@ namespace Rivet {
     /// Get the default/nominal weight index
     size_t _defaultWeightIndex() const;
 
+    /// Get the journal of the @a i'th centrality Percentile restored from a checkpoint
+    string _getJournalPreload(size_t i) const;
+
     /// Get an AO from another analysis
     MultiweightAOPtr _getOtherAnalysisObject(const std::string & ananame, const std::string& name);
 
@@ -785,6 +803,10 @@ namespace Rivet {
     /// Check if we are in the finalize stage.
     bool inFinalize() const;
 
+    /// Calibrate the centrality of all journaled Percentiles from the
+    /// events of this run, and replay the events into their histograms.
+    void _replayJournals();
+
   private:
 
     /// To be used in finalize context only:
@@ -1041,30 +1063,15 @@ namespace Rivet {
       wao->_basePath = yao.path();
       YODAPtrT yaop = make_shared<YODAT>(yao);
 
+      // Create the raw filling YODA object for each weight. Copy from
+      // preloaded YODAs if present. The finalized copies are only made
+      // when first needed, by pushToFinal(), which overwrites them with
+      // the raw objects: preloaded finalized objects are therefore not
+      // looked up, only the /RAW ones.
       for (const string& weightname : _weightNames()) {
-        // Create two YODA objects for each weight. Copy from
-        // preloaded YODAs if present. First the finalized yoda:
-        string finalpath = yao.path();
-        if ( weightname != "" ) finalpath +=  "[" + weightname + "]";
-        YODAPtrT preload = getPreload<YODAT>(finalpath);
-        if ( preload ) {
-          if ( !bookingCompatible(preload, yaop) ) {
-            MSG_WARNING("Found incompatible pre-existing data object with same base path "
-                        << finalpath <<  " for " << name());
-            preload = nullptr;
-          } else {
-            MSG_TRACE("Using preloaded " << finalpath << " in " <<name());
-            wao->_final.push_back(make_shared<YODAT>(*preload));
-          }
-        }
-        if ( !preload ) {
-          wao->_final.push_back(make_shared<YODAT>(yao));
-          wao->_final.back()->setPath(finalpath);
-        }
-
-        // Then the raw filling yodas.
-        string rawpath = "/RAW" + finalpath;
-        preload = getPreload<YODAT>(rawpath);
+        string rawpath = "/RAW" + yao.path();
+        if ( weightname != "" ) rawpath +=  "[" + weightname + "]";
+        YODAPtrT preload = getPreload<YODAT>(rawpath);
         if ( preload ) {
           if ( !bookingCompatible(preload, yaop) ) {
             MSG_WARNING("Found incompatible pre-existing data object with same base path "
@@ -1334,13 +1341,19 @@ namespace Rivet {
     /// The string of options.
     string _optstring;
 
+    /// Journals of Percentiles waiting for a centrality calibration
+    vector<shared_ptr<PercentileJournal> > _journals;
+
+    /// State which a checkpoint of the run cannot save, if any
+    string _uncheckpointed;
+
   private:
 
     /// @name Utility functions
     //@{
 
-    /// Get the reference data for this paper and cache it.
-    void _cacheRefData() const;
+    /// Get the reference data object @a hname for this paper and cache it.
+    void _cacheRefData(const string& hname) const;
 
     //@}
 
@@ -85,7 +85,7 @@ namespace Rivet {
     //@{
 
     /// Get the cross-section known to the handler
-    Scatter1DPtr crossSection() const { return _xs; }
+    Scatter1DPtr crossSection() const { _syncCrossSection(); return _xs; }
 
     /// Set the cross-section for the process being generated
     void setCrossSection(pair<double, double> xsec);
@@ -96,6 +96,7 @@ namespace Rivet {
 
     /// Get the nominal cross-section
     double nominalCrossSection() const {
+      _syncCrossSection();
       _xs.get()->setActiveWeightIdx(_defaultWeightIdx);
       const YODA::Scatter1D::Points& ps = _xs->points();
       if (ps.size() != 1) {
@@ -252,6 +253,33 @@ namespace Rivet {
     /// Write all analyses' plots (via getData) to the named file.
     void writeData(const std::string& filename) const;
 
+    /// @brief Write the state needed to resume this run to the named file
+    ///
+    /// The checkpoint holds the raw analysis objects, the event counter,
+    /// the cross-section, the weight names and the journals of uncalibrated
+    /// centrality Percentiles, together with @a inputoffset, the number of
+    /// events read from the input so far. As for the periodic dumps, the
+    /// current event group is closed first. The file is replaced atomically,
+    /// so an interrupted write leaves the previous checkpoint intact.
+    /// Analyses keeping state outside their analysis objects, eg. event
+    /// mixing pools or correlators, are reported with a warning, since
+    /// such a checkpoint cannot be resumed.
+    void writeCheckpoint(const std::string& filename, size_t inputoffset=0);
+
+    /// @brief Resume from a checkpoint written by writeCheckpoint()
+    ///
+    /// Must be called before init(): the analyses pick up their state when
+    /// they book their objects, and the event weights of the run must have
+    /// the same names as in the checkpoint. Returns the input offset stored
+    /// in the checkpoint, ie. the number of input events to skip. The
+    /// resumed run refuses to start if an analysis keeps state which the
+    /// checkpoint could not save.
+    size_t readCheckpoint(const std::string& filename);
+
+    /// The restored journal of the @a i'th centrality Percentile booked by
+    /// analysis @a ananame, or an empty string if there is none.
+    string getJournalPreload(const string& ananame, size_t i) const;
+
     /// Tell Rivet to dump intermediate result to a file named @a
     /// dumpfile every @a period'th event. If @period is not positive,
     /// no dumping will be done.
@@ -260,6 +288,15 @@ namespace Rivet {
       _dumpFile = dumpfile;
     }
 
+    /// @brief Profile the time spent in each analysis and projection
+    ///
+    /// Text and JSON reports are written to @a reportbase.txt and
+    /// @a reportbase.json whenever finalize() is run. Must be called before
+    /// init(); alternatively set the RIVET_PROFILE environment variable.
+    void profile(const string& reportbase) {
+      _profileFile = reportbase;
+    }
+
     /// Take the vector of yoda files and merge them together using
     /// the cross section and weight information provided in each
     /// file. Each file in @a aofiles is assumed to have been produced
@@ -295,6 +332,18 @@ namespace Rivet {
 
   private:
 
+    /// @brief Rebuild the per-weight cross-section if it is out of date
+    ///
+    /// The variation cross-sections are scaled by the current sumW ratios,
+    /// so the scatter is built on demand rather than on every event.
+    void _syncCrossSection() const;
+
+    /// Collect the analysis objects of all analyses into _rivetAOs
+    void _collectAOs();
+
+    /// The state of analysis @a a which a checkpoint cannot save, if any.
+    string _uncheckpointed(AnaHandle a) const;
+
     /// Current handler stage
     Stage _stage = Stage::OTHER;
 
@@ -305,6 +354,15 @@ namespace Rivet {
     /// Analysis plugged in.
     map<string,YODA::AnalysisObjectPtr> _preloads;
 
+    /// Centrality journals restored from a checkpoint, by analysis name.
+    map<string,vector<string> > _journalPreloads;
+
+    /// Weight names of the run restored from a checkpoint, if any.
+    vector<string> _resumeWeightNames;
+
+    /// Have the analyses which cannot be checkpointed been reported?
+    bool _checkpointWarned = false;
+
     /// A vector containing copies of analysis objects after
     /// finalize() has been run.
     vector<YODA::AnalysisObjectPtr> _finalizedAOs;
@@ -325,7 +383,16 @@ namespace Rivet {
     mutable CounterPtr _eventCounter;
 
     /// Cross-section known to AH
-    Scatter1DPtr _xs;
+    mutable Scatter1DPtr _xs;
+
+    /// Latest cross-section and error reported to the handler
+    pair<double,double> _xsec;
+
+    /// Flag to indicate that _xs needs to be rebuilt from _xsec
+    mutable bool _xsecDirty = false;
+
+    /// Flat list of all analyses' objects, to avoid per-event lookups
+    vector<MultiweightAOPtr> _rivetAOs;
 
     /// Beams used by this run.
     ParticlePair _beams;
@@ -359,6 +426,12 @@ namespace Rivet {
     /// Flag to indicate periodic dumping is in progress
     bool _dumping;
 
+    /// Base name of the profiling report files, or empty if not profiling
+    string _profileFile;
+
+    /// Whether events should be stripped (from RIVET_STRIP_HEPMC)
+    bool _stripEvents = false;
+
     //@}
 
 
@@ -40,12 +40,35 @@ namespace Rivet {
     /// Register a new analysis builder
     static void _registerBuilder(const AnalysisBuilderBase* ab);
 
-    /// Load the available analyses at runtime.
+    /// Load all the available analyses at runtime.
     static void _loadAnalysisPlugins();
 
+    /// @brief Load only the plugin library which the index says provides @a analysisname
+    ///
+    /// Returns false if the name is not in the index, or the library could not be opened.
+    static bool _loadIndexedPlugin(const string& analysisname);
+
+    /// Find the candidate plugin libraries and read their analysis indices, if present.
+    static void _findAnalysisPlugins();
+
+    /// Open a single plugin library, if not already done.
+    static bool _loadPluginLib(const string& path);
+
     typedef map<string, const AnalysisBuilderBase*> AnalysisBuilderMap;
     static AnalysisBuilderMap _ptrs;
 
+    /// Candidate plugin library paths, in search-path order
+    static vector<string> _pluginfiles;
+
+    /// Plugin libraries which have already been opened
+    static set<string> _loadedfiles;
+
+    /// Map of analysis names (and aliases) to the plugin library which provides them
+    static map<string, string> _pluginindex;
+
+    /// Whether every candidate plugin library has an up-to-date index file
+    static bool _fullyIndexed;
+
   };
 
 
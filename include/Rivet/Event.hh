@@ -5,6 +5,7 @@
 #include "Rivet/Config/RivetCommon.hh"
 #include "Rivet/Particle.hh"
 #include "Rivet/Projection.hh"
+#include "Rivet/Tools/Profiler.hh"
 
 namespace Rivet {
 
@@ -26,25 +27,28 @@ namespace Rivet {
     //@{
 
     /// Constructor from a HepMC GenEvent pointer
+    ///
+    /// The GenEvent is wrapped by reference unless stripping or a unit
+    /// conversion is needed, in which case a private working copy is made.
     Event(const GenEvent* ge, bool strip = false)
-      : _genevent_original(ge) {
+      : _genevent_original(ge), _genevent(ge) {
       assert(ge);
-      _genevent = *ge;
-      if ( strip ) _strip(_genevent);
-      _init(*ge);
+      _init(*ge, strip);
     }
 
     /// Constructor from a HepMC GenEvent reference
     /// @deprecated HepMC uses pointers, so we should talk to HepMC via pointers
     Event(const GenEvent& ge, bool strip = false)
-      : _genevent_original(&ge), _genevent(ge) {
-        if ( strip ) _strip(_genevent);
-        _init(ge);
+      : _genevent_original(&ge), _genevent(&ge) {
+        _init(ge, strip);
       }
 
     /// Copy constructor
+    ///
+    /// Any modified working copy of the GenEvent is shared, not duplicated.
     Event(const Event& e)
-      : _genevent_original(e._genevent_original), _genevent(e._genevent)
+      : _genevent_original(e._genevent_original), _genevent(e._genevent),
+        _genevent_copy(e._genevent_copy)
     {  }
 
     //@}
@@ -54,7 +58,7 @@ namespace Rivet {
     //@{
 
     /// The generated event obtained from an external event generator
-    const GenEvent* genEvent() const { return &_genevent; }
+    const GenEvent* genEvent() const { return _genevent; }
 
     /// The generated event obtained from an external event generator
     const GenEvent* originalGenEvent() const { return _genevent_original; }
@@ -137,6 +141,7 @@ namespace Rivet {
         if (old != _projections.end()) {
           log << Log::TRACE << "Equivalent projection found -> returning already-run projection " << *old << std::endl;
           const Projection& pRef = **old;
+          if (Profiler::global().enabled()) Profiler::global().projectionHit(pRef);
           return pcast<PROJ>(pRef);
         }
         log << Log::TRACE << "No equivalent projection in the already-run list -> projecting now" << std::endl;
@@ -146,7 +151,13 @@ namespace Rivet {
       // If this one hasn't been run yet on this event, run it and add to the list
       Projection* pp = const_cast<Projection*>(&p);
       pp->_isValid = true;
-      pp->project(*this);
+      if (Profiler::global().enabled()) {
+        const double t0 = Profiler::clock();
+        pp->project(*this);
+        Profiler::global().projectionCall(*pp, t0);
+      } else {
+        pp->project(*this);
+      }
       if (docaching) _projections.insert(pp);
       return p;
     }
@@ -165,7 +176,10 @@ namespace Rivet {
   private:
 
     /// @brief Actual (shared) implementation of the constructors from GenEvents
-    void _init(const GenEvent& ge);
+    ///
+    /// Only copies the GenEvent if it has to be stripped or converted to
+    /// Rivet's preferred units; otherwise the original is used directly.
+    void _init(const GenEvent& ge, bool strip);
 
     /// @brief Remove uninteresting or unphysical particles in the
     /// GenEvent to speed up searches.
@@ -192,10 +206,13 @@ namespace Rivet {
     /// generator-specific particles stripped out, etc.  If an analysis is
     /// affected by these modifications, it is probably an unphysical analysis!
     ///
-    /// Stored as a non-pointer since it may get overwritten, and memory for
-    /// copying and cleanup is neater this way.
-    /// @todo Change needed for HepMC3?
-    mutable GenEvent _genevent;
+    /// Points either to the original event or to the working copy below.
+    const GenEvent* _genevent;
+
+    /// @brief Modified working copy of the GenEvent, if one was needed
+    ///
+    /// Null when the original event is used as-is.
+    std::shared_ptr<GenEvent> _genevent_copy;
 
     /// All the GenEvent particles, wrapped as Rivet::Particles
     /// @note To be populated lazily, hence mutability
@@ -44,7 +44,7 @@ namespace Rivet {
     size_t size() const { return _particles.size(); }
 
     /// Get the particles in this jet.
-    Particles& particles() { return _particles; }
+    Particles& particles() { _tagbits = TAGBITS_UNSET; return _particles; }
     /// Get the particles in this jet (const version)
     const Particles& particles() const { return _particles; }
     /// Get the particles in this jet which pass a cut (const)
@@ -85,8 +85,18 @@ namespace Rivet {
     /// adds b-hadron, c-hadron, and tau tags by ghost association.
     //@{
 
+    /// @brief Tag classes summarised by tagBits()
+    enum TagBit : unsigned int { BTAG = 1, CTAG = 2, TAUTAG = 4 };
+
+    /// @brief Bitmask of the TagBit classes found on this jet
+    ///
+    /// Worked out from the tags (and the constituent b/c-quark fallbacks) once,
+    /// on first use, so that the un-cut bTagged(), cTagged() and tauTagged()
+    /// queries don't need to rescan tags or constituents.
+    unsigned int tagBits() const;
+
     /// @brief Particles which have been tag-matched to this jet
-    Particles& tags() { return _tags; }
+    Particles& tags() { _tagbits = TAGBITS_UNSET; return _tags; }
     /// @brief Particles which have been tag-matched to this jet (const version)
     const Particles& tags() const { return _tags; }
     /// @brief Particles which have been tag-matched to this jet _and_ pass a selector function
@@ -107,7 +117,7 @@ namespace Rivet {
     Particles bTags(const ParticleSelector& f) const { return filter_select(bTags(), f); }
 
     /// Does this jet have at least one b-tag (that passes an optional Cut)?
-    bool bTagged(const Cut& c=Cuts::open()) const { return !bTags(c).empty(); }
+    bool bTagged(const Cut& c=Cuts::open()) const;
     /// Does this jet have at least one b-tag (that passes the supplied selector function)?
     bool bTagged(const ParticleSelector& f) const { return !bTags(f).empty(); }
 
@@ -120,7 +130,7 @@ namespace Rivet {
     Particles cTags(const ParticleSelector& f) const { return filter_select(cTags(), f); }
 
     /// Does this jet have at least one c-tag (that passes an optional Cut)?
-    bool cTagged(const Cut& c=Cuts::open()) const { return !cTags(c).empty(); }
+    bool cTagged(const Cut& c=Cuts::open()) const;
     /// Does this jet have at least one c-tag (that passes the supplied selector function)?
     bool cTagged(const ParticleSelector& f) const { return !cTags(f).empty(); }
 
@@ -133,10 +143,15 @@ namespace Rivet {
     Particles tauTags(const ParticleSelector& f) const { return filter_select(tauTags(), f); }
 
     /// Does this jet have at least one tau-tag (that passes an optional Cut)?
-    bool tauTagged(const Cut& c=Cuts::open()) const { return !tauTags(c).empty(); }
+    bool tauTagged(const Cut& c=Cuts::open()) const;
     /// Does this jet have at least one tau-tag (that passes the supplied selector function)?
     bool tauTagged(const ParticleSelector& f) const { return !tauTags(f).empty(); }
 
+    /// @brief Does this jet have at least one hadronically-decaying tau tag?
+    ///
+    /// Not cached in tagBits(), as it walks the decay of each tau tag.
+    bool hadronicTauTagged() const;
+
     //@}
 
 
@@ -211,6 +226,12 @@ namespace Rivet {
     /// Particles used to tag this jet (can be anything, but c and b hadrons are the most common)
     Particles _tags;
 
+    /// Marker for tag bits which have not yet been computed
+    static const unsigned int TAGBITS_UNSET = ~0u;
+
+    /// Cached TagBit mask, reset whenever the tags or constituents may change
+    mutable unsigned int _tagbits = TAGBITS_UNSET;
+
     /// Effective jet 4-vector (just for caching)
     mutable FourMomentum _momentum;
 
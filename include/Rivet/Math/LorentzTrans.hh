@@ -175,6 +175,27 @@ namespace Rivet {
       return multiply(_boostMatrix, v4);
     }
 
+    /// @brief Apply this transformation in place to @a n packed 4-vectors
+    ///
+    /// The 4-vectors are stored consecutively in @a p4s as (E, px, py, pz).
+    /// The matrix elements are loaded once for the whole array, so that the
+    /// loop vectorises, rather than paying for a matrix-vector product per
+    /// 4-vector.
+    void transform(double* p4s, size_t n) const {
+      double m[16];
+      for (size_t i = 0; i < 4; ++i)
+        for (size_t j = 0; j < 4; ++j)
+          m[4*i+j] = _boostMatrix.get(i, j);
+      for (size_t k = 0; k < n; ++k) {
+        double* v = p4s + 4*k;
+        const double v0 = v[0], v1 = v[1], v2 = v[2], v3 = v[3];
+        v[0] = m[0]*v0 + m[1]*v1 + m[2]*v2 + m[3]*v3;
+        v[1] = m[4]*v0 + m[5]*v1 + m[6]*v2 + m[7]*v3;
+        v[2] = m[8]*v0 + m[9]*v1 + m[10]*v2 + m[11]*v3;
+        v[3] = m[12]*v0 + m[13]*v1 + m[14]*v2 + m[15]*v3;
+      }
+    }
+
     /// Apply this transformation to the given 4-vector
     FourVector operator () (const FourVector& v4) const {
       return transform(v4);
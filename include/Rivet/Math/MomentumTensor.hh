@@ -0,0 +1,225 @@
+#ifndef RIVET_MATH_MOMENTUMTENSOR
+#define RIVET_MATH_MOMENTUMTENSOR
+
+#include "Rivet/Math/MathHeader.hh"
+#include "Rivet/Math/MathUtils.hh"
+#include "Rivet/Math/Vector3.hh"
+#include <array>
+
+namespace Rivet {
+
+
+  /// @brief Symmetric 3x3 matrix packed as (xx, yy, zz, xy, xz, yz)
+  typedef std::array<double,6> SymMatrix3;
+
+
+  /// @brief Unit eigenvector of a symmetric 3x3 matrix for eigenvalue @a lambda
+  ///
+  /// Taken as the largest cross product of two rows of (m - lambda I), and
+  /// oriented to have a non-negative z component. For a degenerate
+  /// eigenvalue (to 1e-10 relative to the rows) an arbitrary vector in the
+  /// eigenspace is returned.
+  inline Vector3 symEigenvector(const SymMatrix3& m, double lambda) {
+    const Vector3 r0(m[0] - lambda, m[3], m[4]);
+    const Vector3 r1(m[3], m[1] - lambda, m[5]);
+    const Vector3 r2(m[4], m[5], m[2] - lambda);
+    const Vector3 c01 = r0.cross(r1), c02 = r0.cross(r2), c12 = r1.cross(r2);
+    const double n01 = c01.mod2(), n02 = c02.mod2(), n12 = c12.mod2();
+    const double m0 = r0.mod2(), m1 = r1.mod2(), m2 = r2.mod2();
+    const double mmax = max(m0, max(m1, m2));
+
+    Vector3 ev;
+    if (max(n01, max(n02, n12)) > 1e-20*mmax*mmax) {
+      ev = (n01 >= n02 && n01 >= n12) ? c01 : (n02 >= n12 ? c02 : c12);
+    } else {
+      // Rank <= 1: anything orthogonal to the largest row
+      const Vector3& row = (m0 >= m1 && m0 >= m2) ? r0 : (m1 >= m2 ? r1 : r2);
+      if (mmax == 0) return Vector3(0, 0, 1);
+      const Vector3 other = fabs(row.x()) <= fabs(row.y()) ? Vector3(1, 0, 0) : Vector3(0, 1, 0);
+      ev = row.cross(other);
+    }
+    if (ev.z() < 0) ev = -ev;
+    return ev.unit();
+  }
+
+
+  /// @brief Closed-form eigenvalues of a symmetric 3x3 matrix
+  ///
+  /// Uses the trigonometric solution of the characteristic cubic for the
+  /// eigenvalue furthest from the other two, and the 2x2 problem in the plane
+  /// orthogonal to its eigenvector for the remaining pair. The pair is then
+  /// accurate even when (nearly) degenerate, e.g. for back-to-back momenta,
+  /// where the cubic alone only gives sqrt(epsilon) precision.
+  /// The eigenvalues are returned ordered as @a l1 >= @a l2 >= @a l3.
+  inline void symEigenvalues(const SymMatrix3& m, double& l1, double& l2, double& l3) {
+    const double q = (m[0] + m[1] + m[2])/3.;
+    const double p1 = m[3]*m[3] + m[4]*m[4] + m[5]*m[5];
+    const double p2 = sqr(m[0] - q) + sqr(m[1] - q) + sqr(m[2] - q) + 2.*p1;
+    const double p = sqrt(p2/6.);
+    if (p == 0) {
+      l1 = l2 = l3 = q;
+      return;
+    }
+
+    // Half the determinant of (m - q I)/p
+    const double b00 = (m[0] - q)/p, b11 = (m[1] - q)/p, b22 = (m[2] - q)/p;
+    const double b01 = m[3]/p, b02 = m[4]/p, b12 = m[5]/p;
+    const double r = ( b00*(b11*b22 - b12*b12)
+                       - b01*(b01*b22 - b12*b02)
+                       + b02*(b01*b12 - b11*b02) )/2.;
+
+    double phi(0);
+    if (r <= -1) phi = M_PI / 3.;
+    else if (r >= 1) phi = 0;
+    else phi = acos(r) / 3.;
+
+    // For r >= 0 the largest eigenvalue is the isolated one, otherwise the smallest
+    const double liso = r >= 0 ? q + 2 * p * cos(phi) : q + 2 * p * cos(phi + (2*M_PI/3.));
+
+    // Orthonormal basis (u, v) of the plane orthogonal to its eigenvector
+    const Vector3 w = symEigenvector(m, liso);
+    const Vector3 u = (fabs(w.x()) <= fabs(w.y()) ? w.cross(Vector3(1, 0, 0)) : w.cross(Vector3(0, 1, 0))).unit();
+    const Vector3 v = w.cross(u);
+    const Vector3 mu(m[0]*u.x() + m[3]*u.y() + m[4]*u.z(),
+                     m[3]*u.x() + m[1]*u.y() + m[5]*u.z(),
+                     m[4]*u.x() + m[5]*u.y() + m[2]*u.z());
+    const Vector3 mv(m[0]*v.x() + m[3]*v.y() + m[4]*v.z(),
+                     m[3]*v.x() + m[1]*v.y() + m[5]*v.z(),
+                     m[4]*v.x() + m[5]*v.y() + m[2]*v.z());
+    const double a = u.dot(mu), b = u.dot(mv), c = v.dot(mv);
+    const double mean = (a + c)/2., half = hypot((a - c)/2., b);
+
+    if (r >= 0) {
+      l1 = liso;
+      l2 = min(mean + half, l1);
+      l3 = mean - half;
+    } else {
+      l3 = liso;
+      l2 = max(mean - half, l3);
+      l1 = mean + half;
+    }
+  }
+
+
+  /// @brief Raw momentum tensor sums from one pass over a set of momenta
+  ///
+  /// The tensors are left unnormalised: divide by the matching norm to get
+  /// the usual event-shape tensors.
+  struct MomentumTensors {
+    /// Regulated quadratic tensor, \f$ \sum_i |\mathbf{p}_i|^{r-2} p_i^\alpha p_i^\beta \f$
+    SymMatrix3 quad = {{0, 0, 0, 0, 0, 0}};
+    /// Quadratic normalisation, \f$ \sum_i |\mathbf{p}_i|^r \f$
+    double quadNorm = 0;
+    /// Linearised tensor, \f$ \sum_i p_i^\alpha p_i^\beta / |\mathbf{p}_i| \f$
+    SymMatrix3 lin = {{0, 0, 0, 0, 0, 0}};
+    /// Linearised normalisation, \f$ \sum_i |\mathbf{p}_i| \f$
+    double linNorm = 0;
+    /// Linearised transverse tensor (xx, yy, xy), \f$ \sum_i p_{T,i}^\alpha p_{T,i}^\beta / |\mathbf{p}_{T,i}| \f$
+    std::array<double,3> trans = {{0, 0, 0}};
+    /// The regularising power used for the quadratic tensor
+    double r = 2;
+  };
+
+
+  /// @brief Momentum 3-vectors packed as structure-of-arrays
+  ///
+  /// Fill once per event, then compute all the momentum tensors used by the
+  /// event-shape projections in a single vectorisable loop.
+  class PackedMomenta {
+  public:
+
+    /// Reserve space for @a n momenta
+    void reserve(size_t n) { _x.reserve(n); _y.reserve(n); _z.reserve(n); }
+
+    /// Add a momentum from its components
+    void push_back(double x, double y, double z) {
+      _x.push_back(x); _y.push_back(y); _z.push_back(z);
+    }
+
+    /// Add a momentum 3-vector
+    void push_back(const Vector3& p3) { push_back(p3.x(), p3.y(), p3.z()); }
+
+    /// Add the 3-momenta of a collection of objects with px(), py() and pz()
+    template <typename CONTAINER>
+    void add(const CONTAINER& c) {
+      reserve(size() + c.size());
+      for (const auto& x : c) push_back(x.px(), x.py(), x.pz());
+    }
+
+    /// Number of momenta
+    size_t size() const { return _x.size(); }
+
+    /// Is this empty?
+    bool empty() const { return _x.empty(); }
+
+    /// Remove all momenta
+    void clear() { _x.clear(); _y.clear(); _z.clear(); }
+
+
+    /// @brief Accumulate the quadratic tensor with regulator @a r and the linearised tensors
+    ///
+    /// Null momenta (and null transverse momenta, for the transverse tensor)
+    /// are skipped.
+    MomentumTensors tensors(double r=2.0) const {
+      MomentumTensors t;
+      t.r = r;
+      if (r == 2.0) {
+        _accumulate(t, [](double, double p2, double invp, double& w, double& n) { w = invp > 0 ? 1 : 0; n = p2; });
+      } else if (r == 1.0) {
+        _accumulate(t, [](double p, double, double invp, double& w, double& n) { w = invp; n = p; });
+      } else {
+        _accumulate(t, [r](double p, double, double invp, double& w, double& n) {
+            w = invp > 0 ? pow(p, r-2) : 0;
+            n = invp > 0 ? pow(p, r) : 0;
+          });
+      }
+      return t;
+    }
+
+
+  private:
+
+    template <typename REGFN>
+    void _accumulate(MomentumTensors& t, REGFN regfn) const {
+      const double* xs = _x.data();
+      const double* ys = _y.data();
+      const double* zs = _z.data();
+      double q[6] = {0, 0, 0, 0, 0, 0}, qn = 0;
+      double l[6] = {0, 0, 0, 0, 0, 0}, ln = 0;
+      double tr[3] = {0, 0, 0};
+      const size_t n = size();
+      for (size_t i = 0; i < n; ++i) {
+        const double x = xs[i], y = ys[i], z = zs[i];
+        const double xx = x*x, yy = y*y, zz = z*z, xy = x*y, xz = x*z, yz = y*z;
+        const double pt2 = xx + yy;
+        const double p2 = pt2 + zz;
+        const double p = sqrt(p2);
+        const double invp = p > 0 ? 1/p : 0;
+        const double invpt = pt2 > 0 ? 1/sqrt(pt2) : 0;
+        double w, wn;
+        regfn(p, p2, invp, w, wn);
+        q[0] += w*xx; q[1] += w*yy; q[2] += w*zz;
+        q[3] += w*xy; q[4] += w*xz; q[5] += w*yz;
+        qn += wn;
+        l[0] += invp*xx; l[1] += invp*yy; l[2] += invp*zz;
+        l[3] += invp*xy; l[4] += invp*xz; l[5] += invp*yz;
+        ln += p;
+        tr[0] += invpt*xx; tr[1] += invpt*yy; tr[2] += invpt*xy;
+      }
+      for (size_t k = 0; k < 6; ++k) {
+        t.quad[k] = q[k];
+        t.lin[k] = l[k];
+      }
+      for (size_t k = 0; k < 3; ++k) t.trans[k] = tr[k];
+      t.quadNorm = qn;
+      t.linNorm = ln;
+    }
+
+    vector<double> _x, _y, _z;
+
+  };
+
+
+}
+
+#endif
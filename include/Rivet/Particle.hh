@@ -72,12 +72,14 @@ namespace Rivet {
     /// Set the momentum.
     Particle& setMomentum(const FourMomentum& momentum) {
       _momentum = momentum;
+      _invalidateKinematics();
       return *this;
     }
 
     /// Set the momentum via components.
     Particle& setMomentum(double E, double px, double py, double pz) {
       _momentum = FourMomentum(E, px, py, pz);
+      _invalidateKinematics();
       return *this;
     }
 
@@ -58,7 +58,10 @@ namespace Rivet {
     double energy2() const { return momentum().E2(); }
 
     /// Get the \f$ p_T \f$ directly.
-    double pt() const { return momentum().pt(); }
+    double pt() const {
+      if (!(_kinflags & KIN_PT)) { _kinpt = momentum().pt(); _kinflags |= KIN_PT; }
+      return _kinpt;
+    }
     /// Get the \f$ p_T \f$ directly (alias).
     double pT() const { return pt(); }
     /// Get the \f$ p_T \f$ directly (alias).
@@ -82,27 +85,41 @@ namespace Rivet {
     double mass2() const { return momentum().mass2(); }
 
     /// Get the \f$ \eta \f$ directly.
-    double pseudorapidity() const { return momentum().eta(); }
+    double pseudorapidity() const { return eta(); }
     /// Get the \f$ \eta \f$ directly (alias).
-    double eta() const { return momentum().eta(); }
+    double eta() const {
+      if (!(_kinflags & KIN_ETA)) { _kineta = momentum().eta(); _kinflags |= KIN_ETA; }
+      return _kineta;
+    }
     /// Get the \f$ |\eta| \f$ directly.
-    double abspseudorapidity() const { return momentum().abspseudorapidity(); }
+    double abspseudorapidity() const { return fabs(eta()); }
     /// Get the \f$ |\eta| \f$ directly (alias).
-    double abseta() const { return momentum().abseta(); }
+    double abseta() const { return fabs(eta()); }
 
     /// Get the \f$ y \f$ directly.
-    double rapidity() const { return momentum().rapidity(); }
+    double rapidity() const {
+      if (!(_kinflags & KIN_RAP)) { _kinrap = momentum().rapidity(); _kinflags |= KIN_RAP; }
+      return _kinrap;
+    }
     /// Get the \f$ y \f$ directly (alias).
-    double rap() const { return momentum().rapidity(); }
+    double rap() const { return rapidity(); }
     /// Get the \f$ |y| \f$ directly.
-    double absrapidity() const { return momentum().absrapidity(); }
+    double absrapidity() const { return fabs(rapidity()); }
     /// Get the \f$ |y| \f$ directly (alias).
-    double absrap() const { return momentum().absrap(); }
+    double absrap() const { return fabs(rapidity()); }
 
     /// Azimuthal angle \f$ \phi \f$.
-    double azimuthalAngle(const PhiMapping mapping=ZERO_2PI) const { return momentum().azimuthalAngle(mapping); }
+    double azimuthalAngle(const PhiMapping mapping=ZERO_2PI) const {
+      if (!(_kinflags & KIN_PHI)) {
+        // Same convention as Vector3::azimuthalAngle for a null perp-vector
+        const FourMomentum& p4 = momentum();
+        _kinphi = (p4.px() == 0 && p4.py() == 0) ? 0.0 : atan2(p4.py(), p4.px());
+        _kinflags |= KIN_PHI;
+      }
+      return mapAngle(_kinphi, mapping);
+    }
     /// Get the \f$ \phi \f$ directly.
-    double phi(const PhiMapping mapping=ZERO_2PI) const { return momentum().phi(mapping); }
+    double phi(const PhiMapping mapping=ZERO_2PI) const { return azimuthalAngle(mapping); }
 
     /// Get the 3-momentum directly.
     Vector3 p3() const { return momentum().vector3(); }
@@ -149,6 +166,30 @@ namespace Rivet {
 
     //@}
 
+
+  protected:
+
+    /// @brief Discard the cached pT, eta, phi and rapidity
+    ///
+    /// Must be called by derived classes whenever their momentum changes.
+    void _invalidateKinematics() { _kinflags = 0; }
+
+
+  private:
+
+    /// @name Lazily-computed kinematics cache
+    ///
+    /// The transcendental functions behind these are evaluated once per
+    /// momentum, rather than for every cut, sort, deltaR and fill.
+    //@{
+
+    enum KinFlag : unsigned char { KIN_PT = 1, KIN_ETA = 2, KIN_PHI = 4, KIN_RAP = 8 };
+
+    mutable unsigned char _kinflags = 0;
+    mutable double _kinpt = 0, _kineta = 0, _kinphi = 0, _kinrap = 0;
+
+    //@}
+
   };
 
 
@@ -45,15 +45,27 @@ public:
   /// "USR", or "RAW", as described above.
   void add(const SingleValueProjection & p, string pname) {
     _projNames.push_back(pname);
+    const PercentileProjection* pp = dynamic_cast<const PercentileProjection*>(&p);
+    _calibrated.push_back(!pp || pp->calibrated());
+    _increasing.push_back(pp && pp->increasing());
     declare(p, pname);
   }
 
   /// Perform all internal projections.
+  ///
+  /// The value is left unset (ie. -1) if the zero'th projection is not
+  /// calibrated.
   void project(const Event& e) {
+    clear();
     _values.clear();
-    for ( string pname : _projNames )
-      _values.push_back(apply<SingleValueProjection>(e, pname)());
-    if ( !_values.empty() ) set(_values[0]);
+    _raws.clear();
+    for ( string pname : _projNames ) {
+      const SingleValueProjection & p = apply<SingleValueProjection>(e, pname);
+      const PercentileProjection* pp = dynamic_cast<const PercentileProjection*>(&p);
+      _values.push_back(p());
+      _raws.push_back(pp ? pp->raw() : p());
+    }
+    if ( !_values.empty() && _calibrated[0] ) set(_values[0]);
   }
 
   /// Cheek if no internal projections have been added.
@@ -63,11 +75,22 @@ public:
 
   /// Return the percentile of the @a i'th projection.
   ///
-  /// Note that operator() will return the zero'th projection.
+  /// Note that operator() will return the zero'th projection. An
+  /// uncalibrated projection gives -1.
   double operator[](int i) const {
     return _values[i];
   }
 
+  /// @brief Return the raw estimator value of the @a i'th projection.
+  ///
+  /// For a PercentileProjection this is the value of the underlying
+  /// observable, otherwise the same as operator[]. This is what the
+  /// Percentile objects calibrate at the end of the run if no
+  /// calibration was found.
+  double raw(int i = 0) const {
+    return _raws[i];
+  }
+
   // Standard comparison function.
   CmpState compare(const Projection& p) const {
     const CentralityProjection* other = dynamic_cast<const CentralityProjection*>(&p);
@@ -87,6 +110,20 @@ public:
     return _projNames;
   }
 
+  /// @brief Does the @a i'th projection give a percentile?
+  ///
+  /// If not, no calibration was found and it gives -1, while the
+  /// Percentile objects calibrate its raw() value at the end of the
+  /// run.
+  bool calibrated(int i = 0) const {
+    return _calibrated[i];
+  }
+
+  /// Do low values of the @a i'th projection correspond to low percentiles?
+  bool increasing(int i = 0) const {
+    return _increasing[i];
+  }
+
 private:
 
   /// The list of names of the internal projections.
@@ -95,6 +132,15 @@ private:
   /// The list of percentiles resulting from the last projection.
   vector<double> _values;
 
+  /// The list of raw estimator values from the last projection.
+  vector<double> _raws;
+
+  /// Whether each of the internal projections is calibrated.
+  vector<bool> _calibrated;
+
+  /// Whether each of the internal projections is increasing.
+  vector<bool> _increasing;
+
 };
 
 }
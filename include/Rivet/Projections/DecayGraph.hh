@@ -0,0 +1,72 @@
+// -*- C++ -*-
+#ifndef RIVET_DecayGraph_HH
+#define RIVET_DecayGraph_HH
+
+#include "Rivet/Projection.hh"
+#include "Rivet/Particle.hh"
+#include "Rivet/Event.hh"
+
+namespace Rivet {
+
+
+  /// @brief Decay-chain relations of particles in the event graph
+  ///
+  /// The child relations only need the particle's own decay vertex and are
+  /// available as static functions. The number of decayed hadron generations
+  /// above a particle needs a walk up the graph: it is worked out only when
+  /// asked for, and memoised per production vertex for the rest of the event,
+  /// so that all the PrimaryHadrons projections in a run share the ancestor walks.
+  class DecayGraph : public Projection {
+  public:
+
+    /// Default (and only) constructor
+    DecayGraph() { setName("DecayGraph"); }
+
+    /// Clone on the heap
+    DEFAULT_RIVET_PROJ_CLONE(DecayGraph);
+
+
+    /// @name Child relations
+    //@{
+
+    /// No status = 2 child with the same PDG ID, i.e. the last copy in a replica chain
+    static bool lastCopy(ConstGenParticlePtr gp);
+
+    /// At least one child contains a b quark
+    static bool bottomChild(ConstGenParticlePtr gp);
+
+    /// At least one child contains a c quark
+    static bool charmChild(ConstGenParticlePtr gp);
+
+    //@}
+
+
+    /// Number of generations of decayed (status = 2) hadrons or taus above @a gp
+    unsigned int hadronDepth(ConstGenParticlePtr gp) const {
+      return _vertexDepth(gp->production_vertex());
+    }
+
+
+  protected:
+
+    /// Project on to the Event
+    void project(const Event& e);
+
+    /// Compare with other projections -- it's always the same, since there are no params
+    CmpState compare(const Projection&) const { return CmpState::EQ; }
+
+
+  private:
+
+    /// Depth of decayed hadrons above vertex @a vtx, memoised in _depths
+    unsigned int _vertexDepth(ConstGenVertexPtr vtx) const;
+
+    /// Memoised vertex depths, indexed by minus the vertex unique ID; -1 if not yet known
+    mutable vector<int> _depths;
+
+  };
+
+
+}
+
+#endif
@@ -4,6 +4,7 @@
 
 #include "Rivet/Projection.hh"
 #include "Rivet/Projections/FinalState.hh"
+#include "Rivet/Projections/Sphericity.hh"
 #include "Rivet/Event.hh"
 
 namespace Rivet {
@@ -76,8 +77,11 @@ namespace Rivet {
 
   private:
 
-    /// Actually do the calculation
-    void _calcFParameter(const vector<Vector3>& fsmomenta);
+    /// Calculate the F-parameter from packed momenta
+    void _calcFParameter(const PackedMomenta& fsmomenta);
+
+    /// Actually do the calculation, from the transverse tensor (xx, yy, xy)
+    void _calcFParameter(const std::array<double,3>& mMom);
 
   };
 }
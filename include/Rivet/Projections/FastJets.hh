@@ -285,6 +285,16 @@ namespace Rivet {
     /// Particles used for constituent and tag lookup
     Particles _fsparticles, _tagparticles;
 
+    /// @brief Jets built from the current clustering
+    ///
+    /// Built on first request, so the constituent/tag lookup is only done
+    /// once per event for all analyses sharing this projection. The tag
+    /// bits are only worked out if a jet is queried for them.
+    mutable Jets _jetcache;
+
+    /// Whether _jetcache is valid for the current clustering
+    mutable bool _jetcacheValid = false;
+
   };
 
 }
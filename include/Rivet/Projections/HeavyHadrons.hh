@@ -4,6 +4,7 @@
 
 #include "Rivet/Projections/FinalState.hh"
 #include "Rivet/Projections/UnstableParticles.hh"
+#include "Rivet/Projections/DecayGraph.hh"
 #include "Rivet/Particle.hh"
 #include "Rivet/Event.hh"
 
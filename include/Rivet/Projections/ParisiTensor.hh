@@ -33,8 +33,9 @@ namespace Rivet {
   /// D = 27 \lambda_1\lambda_2\lambda_3
   /// \f]
   ///
-  /// Internally, this Projection uses the Sphericity projection with the generalising
-  /// \f$r\f$ parameter set to 1.
+  /// Internally, this Projection takes the linearised tensor accumulated by the
+  /// default Sphericity projection, so both are computed in one pass over the
+  /// final state and share the projection cache.
   ///
   class ParisiTensor : public Projection {
   public:
@@ -44,7 +45,7 @@ namespace Rivet {
     {
       setName("ParisiTensor");
       declare(fsp, "FS");
-      declare(Sphericity(fsp, 1.0), "Sphericity");
+      declare(Sphericity(fsp), "Sphericity");
       clear();
     }
 
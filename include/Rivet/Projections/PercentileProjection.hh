@@ -26,7 +26,7 @@ public:
   /// @todo Use mkScatter to pass this to the Scatter2D-calibrated version?
   PercentileProjection(const SingleValueProjection & sv, const Histo1D& calhist,
                   bool increasing = false)
-    : _calhist("EMPTY"), _increasing(increasing) {
+    : _calhist("EMPTY"), _increasing(increasing), _calibrated(true) {
     declare(sv, "OBSERVABLE");
     //if ( !calhist ) return;
     MSG_INFO("Constructing PercentileProjection from " << calhist.path());
@@ -56,7 +56,7 @@ public:
   // lower percentiles.
   PercentileProjection(const SingleValueProjection & sv, const Scatter2D& calscat,
                   bool increasing = false)
-    : _calhist("EMPTY"), _increasing(increasing) {
+    : _calhist("EMPTY"), _increasing(increasing), _calibrated(true) {
     declare(sv, "OBSERVABLE");
 
     //if ( !calscat ) return;
@@ -82,17 +82,30 @@ public:
     }
   }
 
+  // Constructor taking a SingleValueProjection for which there is no
+  // calibration histogram. No percentile (ie. -1) is then reported,
+  // but the Percentile objects using it calibrate the raw value of the
+  // observable from the events of the run itself (see
+  // PercentileJournal).
+  PercentileProjection(const SingleValueProjection & sv, bool increasing = false)
+    : _calhist("UNCALIBRATED"), _increasing(increasing), _calibrated(false) {
+    declare(sv, "OBSERVABLE");
+    MSG_INFO("Constructing uncalibrated PercentileProjection");
+  }
+
   DEFAULT_RIVET_PROJ_CLONE(PercentileProjection);
 
   // The projection function takes the assigned SingeValueProjection
   // and sets the value of this projection to the corresponding
   // percentile. If no calibration has been provided, -1 will be
   // returned. If values are outside of the calibration histogram, 0
-  // or 100 will be returned.
+  // or 100 will be returned. The value of the observable itself is
+  // available from raw().
   void project(const Event& e) {
     clear();
-    if ( _table.empty() ) return;
-    double obs = apply<SingleValueProjection>(e, "OBSERVABLE")();
+    _raw = apply<SingleValueProjection>(e, "OBSERVABLE")();
+    if ( !_calibrated || _table.empty() ) return;
+    double obs = _raw;
     double pcnt = lookup(obs);
     if ( pcnt >= 0.0 ) set(pcnt);
   }
@@ -106,6 +119,16 @@ public:
       cmp(_calhist, pp._calhist);
   }
 
+  // Does this projection give percentiles rather than the raw observable?
+  bool calibrated() const { return _calibrated; }
+
+  // Do low values of the observable correspond to low percentiles?
+  bool increasing() const { return _increasing; }
+
+  // The raw value of the observable in the last event, eg. for
+  // calibrating an uncalibrated projection.
+  double raw() const { return _raw; }
+
 private:
 
   // The (interpolated) lookup table
@@ -129,6 +152,12 @@ private:
   // below or above.
   bool _increasing;
 
+  // A flag to say whether a calibration has been provided.
+  bool _calibrated;
+
+  // The raw value of the observable in the last event.
+  double _raw = -1.0;
+
 };
 
 
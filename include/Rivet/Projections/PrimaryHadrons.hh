@@ -4,6 +4,7 @@
 
 #include "Rivet/Projections/FinalState.hh"
 #include "Rivet/Projections/UnstableParticles.hh"
+#include "Rivet/Projections/DecayGraph.hh"
 #include "Rivet/Particle.hh"
 #include "Rivet/Event.hh"
 
@@ -24,6 +25,7 @@ namespace Rivet {
     PrimaryHadrons(const Cut& c=Cuts::open()) {
       setName("PrimaryHadrons");
       declare(UnstableParticles(c), "UFS");
+      declare(DecayGraph(), "Graph");
     }
 
     /// Constructor with specification of the minimum and maximum pseudorapidity
@@ -31,6 +33,7 @@ namespace Rivet {
     PrimaryHadrons(double mineta, double maxeta, double minpt=0.0*GeV) {
       setName("PrimaryHadrons");
       declare(UnstableParticles(Cuts::etaIn(mineta, maxeta) && Cuts::pT > minpt), "UFS");
+      declare(DecayGraph(), "Graph");
     }
 
 
@@ -56,10 +56,10 @@ namespace Rivet {
 /// throwing a fastjet::Error exception; if the user wishes to have
 /// robust code, they should catch this exception.
 ///
-/// Pxcone has a hard-coded limit (by default 4000) on the maximum
-/// number of particles and protojets; if the number of particles or
-/// protojets exceeds this, again a fastjet::Error exception will be
-/// thrown.
+/// This version stores particles and protojets dynamically, so unlike
+/// the fortran original it has no limit on their number. In the
+/// hadron-hadron mode particles are indexed by phi and each cone only
+/// tests its neighbours; the jets found are unchanged.
 ///
 /// The functionality of pxcone is described at 
 /// http://www.hep.man.ac.uk/u/wplano/ConeJet.ps
@@ -7,6 +7,7 @@
 #include "Rivet/Projections/FinalState.hh"
 #include "Rivet/Event.hh"
 #include "Rivet/Jet.fhh"
+#include "Rivet/Math/MomentumTensor.hh"
 
 namespace Rivet {
 
@@ -119,6 +120,12 @@ namespace Rivet {
     double lambda3() const { return _lambdas[2]; }
     //@}
 
+    /// @brief The unnormalised momentum tensors from the last calculation
+    ///
+    /// Besides the regulated tensor used here, this includes the linearised
+    /// and transverse tensors used by ParisiTensor and FParameter.
+    const MomentumTensors& momentumTensors() const { return _tensors; }
+
     Vector3 mkEigenVector(Matrix3 A, const double &lambda);
 
     /// @name Direct methods
@@ -137,9 +144,7 @@ namespace Rivet {
     /// Manually calculate the sphericity, without engaging the caching system
     void calc(const vector<FourMomentum>& momenta);
 
-    /// @brief Manually calculate the sphericity, without engaging the caching system
-    ///
-    /// This one actually does the calculation
+    /// Manually calculate the sphericity, without engaging the caching system
     void calc(const vector<Vector3>& momenta);
 
     //@}
@@ -156,6 +161,12 @@ namespace Rivet {
     /// Regularizing parameter, used to force infra-red safety.
     const double _regparam;
 
+    /// Momentum tensor sums.
+    MomentumTensors _tensors;
+
+    /// Do the calculation on packed momenta
+    void _calc(const PackedMomenta& momenta);
+
   };
 
 
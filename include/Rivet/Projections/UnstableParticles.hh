@@ -3,6 +3,7 @@
 #define RIVET_UnstableParticles_HH
 
 #include "Rivet/Projections/FinalState.hh"
+#include "Rivet/Projections/DecayGraph.hh"
 
 namespace Rivet {
 
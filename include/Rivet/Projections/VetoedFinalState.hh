@@ -213,6 +213,18 @@ namespace Rivet {
 
   private:
 
+    /// @brief Flag the members of all @a n-particle combinations with a composite mass in a veto window
+    ///
+    /// Combinations are built depth-first in index order, extending the
+    /// partial sum @a psum of the current @a members from index @a start.
+    void _vetoComposites(size_t n, const vector<pair<double,double> >& massRanges, double maxMass,
+                         size_t start, const FourMomentum& psum,
+                         vector<size_t>& members, vector<bool>& vetoed) const;
+
+    /// Whether any ancestor of @a vtx has a vetoed parent ID, memoised per vertex in @a vtxvetoes
+    bool _hasVetoedAncestor(ConstGenVertexPtr vtx, map<ConstGenVertexPtr, bool>& vtxvetoes) const;
+
+
     /// The veto cuts
     vector<Cut> _vetoCuts;
 
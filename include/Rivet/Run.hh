@@ -58,6 +58,27 @@ namespace Rivet {
     /// Handle next event
     bool processEvent();
 
+    /// @brief Skip up to @a n events, reading a new event after each
+    ///
+    /// Returns the number of events skipped, which is smaller than @a n
+    /// if the end of the input was reached.
+    size_t skipEvents(size_t n);
+
+    /// @brief Process up to @a n events, reading a new event after each
+    ///
+    /// The whole loop runs in C++, so that the Python driver only needs to
+    /// regain control every @a n events for progress reports, signals and
+    /// the run timeout. If @a evttimeout is non-zero, an alarm signal is
+    /// scheduled to interrupt the reading of each event after that many
+    /// seconds. Returns the number of events processed, which is smaller
+    /// than @a n if the end of the input was reached, a read was
+    /// interrupted or the processing of an event failed (see
+    /// eventFailed()).
+    size_t processEvents(size_t n, unsigned int evttimeout=0);
+
+    /// Did the processing of an event stop the last processEvents() call?
+    bool eventFailed() const { return _evtfailed; }
+
     /// Close up HepMC I/O
     bool finalize();
 
@@ -92,6 +113,12 @@ namespace Rivet {
     /// Current event
     std::shared_ptr<GenEvent> _evt;
 
+    /// Was the current event read successfully?
+    bool _evtok;
+
+    /// Did processEvents() stop on an event that failed to be processed?
+    bool _evtfailed;
+
     /// Output stream for HepMC writer
     std::shared_ptr<std::istream> _istr;
 
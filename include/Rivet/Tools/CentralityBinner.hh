@@ -136,6 +136,10 @@ struct MergeDistance {
  * example, a CentralityBinner may e.g. contain histograms of the
  * cross section differential in \f$ p_T \f$ in different centrality
  * regions for heavy ion collisions based on forward energy flow.
+ *
+ * The binner keeps its bins outside the analysis objects, so an
+ * analysis using it should call Analysis::declareUncheckpointed() in
+ * its init method, as a run cannot be resumed from a checkpoint.
  **/
 template <typename T = Histo1DPtr, typename MDist = MergeDistance>
 class CentralityBinner: public ProjectionApplier {
@@ -146,11 +150,30 @@ class CentralityBinner: public ProjectionApplier {
   /// typically enough. @a wlim is the mximum allowed error allowed
   /// for the centrality limits before a warning is emitted.
   CentralityBinner(int maxbins = 200, double wlim = 0.02)
-    : _currentCEst(-1.0), _maxBins(maxbins), _warnlimit(wlim), _weightsum(0.0) {
+    : _currentCEst(-1.0), _maxBins(maxbins), _warnlimit(wlim),
+      _sketchEps(0.0), _weightsum(0.0) {
     _percentiles.insert(0.0);
     _percentiles.insert(1.0);
   }
 
+  /// Estimate the percentile edges with a quantile sketch instead of
+  /// the MergeDistance-driven merging. The dynamic bins then behave
+  /// like the centroids of a t-digest: an event is absorbed by the
+  /// nearest bin if that keeps the bin's weight fraction below @a
+  /// epsilon plus its distance in percentile to the nearest
+  /// requested edge, and all bins are compressed in one sweep once
+  /// there are more than @a maxbins of them. The bins straddling an
+  /// edge therefore hold at most a fraction @a epsilon of the events,
+  /// while the number of bins (and AnalysisObject clones) stays bounded
+  /// by the maximum regardless of the number of events. A bin that an
+  /// event would take over the bound is halved in estimator range,
+  /// assuming its events to be evenly spread as finalize() does, so the
+  /// bound only fails for bins of a single estimator value. If @a
+  /// epsilon is too small for that, it is doubled as needed.
+  void setSketch(double epsilon = 0.001) {
+    _sketchEps = epsilon;
+  }
+
   /// Set the centrality projection to be used. Note that this
   /// projection must have already been declared to Rivet.
   void setProjection(const CentralityEstimator & p, string pname) {
@@ -375,12 +398,48 @@ protected:
   typename FlexiBinSet::iterator _findBin(double cest) {
     if ( _flexiBins.empty() ) return _flexiBins.end();
     auto it = _flexiBins.lower_bound(FlexiBin(cest));
-    if ( it->_cestLo == cest ) return it;
+    if ( it != _flexiBins.end() && it->_cestLo == cest ) return it;
     if ( it != _flexiBins.begin() ) --it;
     if ( it->_cestLo < cest && cest < it->_cestHi ) return it;
     return _flexiBins.end();
   }
 
+  /// Select the bin for an event in the quantile-sketch mode.
+  T _sketchSelect(double cest, double weight);
+
+  /// The fraction of the total weight in the dynamic bins before @a it.
+  double _weightBefore(typename FlexiBinSet::iterator it) const {
+    double acc = 0.0;
+    for ( auto i = _flexiBins.begin(); i != it; ++i ) acc += i->_weightsum;
+    return acc/_weightsum;
+  }
+
+  /// The largest allowed weight fraction of a sketch bin covering the
+  /// percentile range [@a qlo, @a qhi].
+  double _sketchBound(double qlo, double qhi) const {
+    double d = 1.0;
+    for ( double e : _percentiles ) {
+      if ( e <= 0.0 || e >= 1.0 ) continue;
+      if ( e < qlo ) d = min(d, qlo - e);
+      else if ( e > qhi ) d = min(d, e - qhi);
+      else d = 0.0;
+    }
+    return _sketchEps + d;
+  }
+
+  /// Split the sketch bin @a it at the estimator value @a mid,
+  /// sharing its contents equally between the halves as finalize()
+  /// would, and return the half containing @a cest.
+  typename FlexiBinSet::iterator
+  _sketchSplit(typename FlexiBinSet::iterator it, double mid, double cest);
+
+  /// Merge neighbouring sketch bins as far as the bound allows.
+  void _sketchCompress();
+
+  /// Compress the sketch bins if there are too many, and return the
+  /// AnalysisObject of the bin now holding the estimator value @a cest.
+  T _sketchCurrent(double cest);
+
   /// The name of the CentralityEstimator projection to be used.
   string _estimator;
 
@@ -399,6 +458,10 @@ protected:
   /// centrality bins exceeds this, emit a warning.
   double _warnlimit;
 
+  /// The rank error allowed at the percentile edges in the
+  /// quantile-sketch mode, which is off if this is not positive.
+  double _sketchEps;
+
   /// The unfilled AnalysisObjectss where the esimator edges has not yet
   /// been determined.
   vector<Bin> _unfilled;
@@ -629,6 +692,8 @@ T CentralityBinner<T,MDist>::select(double cest, double weight) {
     return _currenT;
   }
 
+  if ( _sketchEps > 0.0 ) return _sketchSelect(cest, weight);
+
   auto it = _findBin(cest);
   if ( it == _flexiBins.end() ) {
     _currenT = CentralityBinTraits<T>::clone(_unfilled.begin()->_t);
@@ -681,6 +746,111 @@ T CentralityBinner<T,MDist>::select(double cest, double weight) {
 }
 
 
+template <typename T, typename MDist>
+T CentralityBinner<T,MDist>::_sketchSelect(double cest, double weight) {
+
+  // An event inside an existing bin may take it over the bound, in
+  // which case the bin is halved until it is within the bound again or
+  // cannot be split any further (e.g. for a single estimator value).
+  auto it = _findBin(cest);
+  while ( it != _flexiBins.end() ) {
+    double qlo = _weightBefore(it);
+    double qhi = qlo + (it->_weightsum + weight)/_weightsum;
+    double mid = (it->_cestLo + it->_cestHi)/2.0;
+    if ( qhi - qlo <= _sketchBound(qlo, qhi) ||
+         !( it->_cestLo < mid && mid < it->_cestHi ) ) {
+      it->_weightsum += weight;
+      ++(it->_n);
+      return _sketchCurrent(cest);
+    }
+    it = _sketchSplit(it, mid, cest);
+  }
+
+  // Otherwise try to widen the nearest bin to include this event.
+  auto hi = _flexiBins.lower_bound(FlexiBin(cest));
+  auto near = hi;
+  if ( hi != _flexiBins.begin() ) {
+    auto lo = std::prev(hi);
+    if ( hi == _flexiBins.end() || cest - lo->_cestHi <= hi->_cestLo - cest )
+      near = lo;
+  }
+  if ( near != _flexiBins.end() ) {
+    double qlo = _weightBefore(near);
+    double qhi = qlo + (near->_weightsum + weight)/_weightsum;
+    if ( qhi - qlo <= _sketchBound(qlo, qhi) ) {
+      FlexiBin fb = *near;
+      fb._cestLo = min(fb._cestLo, cest);
+      fb._cestHi = max(fb._cestHi, cest);
+      fb._weightsum += weight;
+      ++fb._n;
+      _flexiBins.insert(_flexiBins.erase(near), fb);
+      return _sketchCurrent(cest);
+    }
+  }
+
+  T t = CentralityBinTraits<T>::clone(_unfilled.begin()->_t);
+  _flexiBins.insert(FlexiBin(t, cest, weight));
+  return _sketchCurrent(cest);
+
+}
+
+
+template <typename T, typename MDist>
+T CentralityBinner<T,MDist>::_sketchCurrent(double cest) {
+  if ( (int)_flexiBins.size() > _maxBins ) _sketchCompress();
+  // The bin holding cest is the last one starting at or below it
+  return _currenT = std::prev(_flexiBins.upper_bound(FlexiBin(cest)))->_t;
+}
+
+
+template <typename T, typename MDist>
+typename CentralityBinner<T,MDist>::FlexiBinSet::iterator
+CentralityBinner<T,MDist>::_sketchSplit(typename FlexiBinSet::iterator it,
+                                        double mid, double cest) {
+  FlexiBin lo = *it;
+  T t = CentralityBinTraits<T>::clone(lo._t);
+  CentralityBinTraits<T>::scale(lo._t, 0.5);
+  CentralityBinTraits<T>::scale(t, 0.5);
+  FlexiBin hi(t, mid, lo._weightsum/2.0);
+  hi._cestHi = lo._cestHi;
+  hi._n = lo._n/2;
+  hi._m = lo._m;
+  lo._cestHi = mid;
+  lo._weightsum /= 2.0;
+  lo._n -= hi._n;
+  auto next = _flexiBins.erase(it);
+  auto hiit = _flexiBins.insert(next, hi);
+  auto loit = _flexiBins.insert(hiit, lo);
+  return cest < mid ? loit : hiit;
+}
+
+
+template <typename T, typename MDist>
+void CentralityBinner<T,MDist>::_sketchCompress() {
+  while ( true ) {
+    FlexiBinSet compressed;
+    double acc = 0.0;
+    auto it = _flexiBins.begin();
+    while ( it != _flexiBins.end() ) {
+      FlexiBin fb = *it++;
+      double qlo = acc/_weightsum;
+      while ( it != _flexiBins.end() ) {
+        double qhi = (acc + fb._weightsum + it->_weightsum)/_weightsum;
+        if ( qhi - qlo > _sketchBound(qlo, qhi) ) break;
+        fb.merge(*it++);
+      }
+      acc += fb._weightsum;
+      compressed.insert(compressed.end(), fb);
+    }
+    _flexiBins.swap(compressed);
+    if ( 4*(int)_flexiBins.size() <= 3*_maxBins ) return;
+    _sketchEps *= 2.0;
+    MSG_DEBUG("Too many sketch bins for the requested percentiles, "
+              << "increasing the allowed rank error to " << _sketchEps);
+  }
+}
+
+
 template <typename T, typename MDist>
 void CentralityBinner<T,MDist>::finalize() {
 
@@ -318,6 +318,13 @@ namespace Rivet {
     CorBin() : binIndex(0), nBins(BOOT_BINS) {
       for(size_t i = 0; i < nBins; ++i) bins.push_back(CorSingleBin());
     }
+
+    // @brief Construct from the packed moments of the bootstrap bins,
+    // as stored in a CorBootstrap.
+    explicit CorBin(const double* moments) : CorBin() {
+      for (size_t i = 0; i < nBins; ++i, moments += 4)
+        bins[i].addContent(moments[3], moments[1], moments[2], moments[0]);
+    }
     // Destructor must be implemented.
 
     ~CorBin() {}
@@ -365,6 +372,81 @@ namespace Rivet {
 
   }; // End of CorBin sub-class.
 
+  /// @brief Compact bootstrap accumulator for all the bins of an ECorrelator.
+  /// The moments of the CorSingleBins of every bin and bootstrap sample are
+  /// kept in one contiguous array, indexed as [bin][sample][moment], instead
+  /// of a CorBin object per bin. Each fill of an ECorrelator takes the next
+  /// sample from a counter, so all bins filled by one event end up in the
+  /// same sample. All moments are plain sums, so outputs of separate jobs
+  /// merge exactly.
+  class CorBootstrap {
+  public:
+    // The moments stored for each bin and sample.
+    enum Moment { SUMWX = 0, SUMW, SUMW2, NUMENTRIES, NMOMENTS };
+
+    // @brief Constructor for @parm nBinsIn bins.
+    CorBootstrap(size_t nBinsIn = 0) :
+      moments(nBinsIn * BOOT_BINS * NMOMENTS, 0.), nBins(nBinsIn),
+      counter(0) {}
+
+    // @brief The sample to use for the next event.
+    size_t nextSample() {
+      const size_t sample = counter % BOOT_BINS;
+      ++counter;
+      return sample;
+    }
+
+    // @brief Fill bin @parm index in bootstrap @parm sample with the return
+    // type from a Correlator.
+    void fill(size_t index, size_t sample, const pair<double, double>& cor,
+      const double weight = 1.0) {
+      // Test if denominator for the single event average is zero.
+      if (cor.second < 1e-10) return;
+      double* m = &moments[(index * BOOT_BINS + sample) * NMOMENTS];
+      const double wc = weight * cor.second;
+      m[SUMWX] += cor.first * weight;
+      m[SUMW] += wc;
+      m[SUMW2] += wc * wc;
+      m[NUMENTRIES] += 1.;
+    }
+
+    // @brief Add content to bin @parm index in bootstrap @parm sample.
+    void addContent(size_t index, size_t sample, double ne, double sw,
+      double sw2, double swx) {
+      double* m = &moments[(index * BOOT_BINS + sample) * NMOMENTS];
+      m[SUMWX] += swx;
+      m[SUMW] += sw;
+      m[SUMW2] += sw2;
+      m[NUMENTRIES] += ne;
+    }
+
+    // @brief Get bin @parm index as a CorBin.
+    CorBin bin(size_t index) const {
+      return CorBin(&moments[index * BOOT_BINS * NMOMENTS]);
+    }
+
+    // @brief Replace bin @parm index with the content of a CorBin.
+    void setBin(size_t index, const CorBin& corBin) {
+      fill_n(moments.begin() + index * BOOT_BINS * NMOMENTS,
+        BOOT_BINS * NMOMENTS, 0.);
+      const vector<CorSingleBin> bins = corBin.getBins();
+      for (size_t i = 0; i < bins.size() && i < size_t(BOOT_BINS); ++i)
+        addContent(index, i, bins[i].numEntries(), bins[i].sumW(),
+          bins[i].sumW2(), bins[i].sumWX());
+    }
+
+    // @brief The number of bins.
+    size_t size() const {
+      return nBins;
+    }
+
+  private:
+    vector<double> moments;
+    size_t nBins;
+    size_t counter;
+
+  }; // End of CorBootstrap sub-class.
+
   public:
   /// @brief The ECorrelator is a helper class to calculate all event
   /// averages of correlators, in order to construct cumulants.
@@ -384,13 +466,12 @@ namespace Rivet {
     /// of correlated particles as a generic framework style vector, eg,
     /// {2, -2} for <<2>>_2 and binning.
     ECorrelator(vector<int> h, vector<double> binIn) : h1(h), h2({}),
-      binX(binIn), binContent(binIn.size() - 1), reference() {};
+      binX(binIn), boot(binIn.size()) {};
 
     /// @brief Constructor for gapped correlator. Takes as argument the
     /// desired harmonics for the two final states, and binning.
     ECorrelator(vector<int> h1In, vector<int> h2In, vector<double> binIn) :
-      h1(h1In), h2(h2In), binX(binIn), binContent(binIn.size() - 1),
-      reference() {};
+      h1(h1In), h2(h2In), binX(binIn), boot(binIn.size()) {};
 
     /// @brief Fill the appropriate bin given an input (per event)
     /// observable, eg. centrality.
@@ -398,7 +479,7 @@ namespace Rivet {
       const double weight = 1.0) {
       int index = getBinIndex(obs);
       if (index < 0) return;
-      binContent[index].fill(c.intCorrelator(h1), weight);
+      boot.fill(index, boot.nextSample(), c.intCorrelator(h1), weight);
     }
 
     /// @brief Fill the appropriate bin given an input (per event)
@@ -413,7 +494,8 @@ namespace Rivet {
       }
       int index = getBinIndex(obs);
       if (index < 0) return;
-      binContent[index].fill(c1.intCorrelatorGap(c2, h1, h2), weight);
+      boot.fill(index, boot.nextSample(), c1.intCorrelatorGap(c2, h1, h2),
+        weight);
     }
 
     /// @brief Fill the bins with the appropriate correlator, taking the
@@ -424,12 +506,13 @@ namespace Rivet {
       // We always skip overflow when calculating the all event average.
       if (diffCorr.size() != binX.size() - 1)
         cout << "Tried to fill event with wrong binning (ungapped)" << endl;
+      const size_t sample = boot.nextSample();
       for (size_t i = 0; i < diffCorr.size(); ++i) {
         int index = getBinIndex(binX[i]);
         if (index < 0) return;
-        binContent[index].fill(diffCorr[i], weight);
+        boot.fill(index, sample, diffCorr[i], weight);
       }
-      reference.fill(c.intCorrelator(h1), weight);
+      boot.fill(refIndex(), sample, c.intCorrelator(h1), weight);
     }
 
     /// @brief Fill bins with the appropriate correlator, taking the binning
@@ -446,23 +529,29 @@ namespace Rivet {
       // We always skip overflow when calculating the all event average.
       if (diffCorr.size() != binX.size() - 1)
         cout << "Tried to fill event with wrong binning (gapped)" << endl;
+      const size_t sample = boot.nextSample();
       for (size_t i = 0; i < diffCorr.size(); ++i) {
 	int index = getBinIndex(binX[i]);
 	if (index < 0) return;
-        binContent[index].fill(diffCorr[i], weight);
+        boot.fill(index, sample, diffCorr[i], weight);
       }
-      reference.fill(c1.intCorrelatorGap(c2, h1, h2), weight);
+      boot.fill(refIndex(), sample, c1.intCorrelatorGap(c2, h1, h2), weight);
     }
 
     /// @brief Get a copy of the bin contents.
     const vector<CorBin> getBins() const {
-      return binContent;
+      vector<CorBin> ret;
+      ret.reserve(refIndex());
+      for (size_t i = 0; i < refIndex(); ++i) ret.push_back(boot.bin(i));
+      return ret;
     }
 
-    // @brief Return the bins as pointers to the base class.
+    // @brief Return the bins as pointers to the base class. The pointers
+    // stay valid until the next call.
     const vector<CorBinBase*> getBinPtrs() {
-      vector<CorBinBase*> ret(binContent.size());
-      transform(binContent.begin(), binContent.end(), ret.begin(),
+      binView = getBins();
+      vector<CorBinBase*> ret(binView.size());
+      transform(binView.begin(), binView.end(), ret.begin(),
         [](CorBin& b) {return &b;});
       return ret;
     }
@@ -486,12 +575,13 @@ namespace Rivet {
     /// flow bin, eg. calculated in another phase space or with
     /// other pid.
     void setReference(CorBin refIn) {
-      reference = refIn;
+      boot.setBin(refIndex(), refIn);
     }
 
     /// @brief Extract the reference flow from a differential event
     /// averaged correlator.
     const CorBin getReference() const {
+      const CorBin reference = boot.bin(refIndex());
       if (reference.mean() < 1e-10)
         cout << "Warning: ECorrelator, reference bin is zero." << endl;
       return reference;
@@ -506,18 +596,16 @@ namespace Rivet {
     /// @brief Fill bins with content from preloaded histograms.
     void fillFromProfs() {
       list<Profile1DPtr>::iterator hItr = profs.begin();
-      auto refs = reference.getBinPtrs<CorSingleBin>();
       for (size_t i = 0; i < profs.size(); ++i, ++hItr) {
 	for (size_t j = 0; j < binX.size() - 1; ++j) {
 	  const YODA::ProfileBin1D& pBin = (*hItr)->binAt(binX[j]);
-	  auto tmp  = binContent[j].getBinPtrs<CorSingleBin>();
-	  tmp[i]->addContent(pBin.numEntries(), pBin.sumW(), pBin.sumW2(),
+	  boot.addContent(j, i, pBin.numEntries(), pBin.sumW(), pBin.sumW2(),
 	    pBin.sumWY());
 	}
 	// Get the reference flow from the underflow bin of the histogram.
 	const YODA::Dbn2D& uBin = (*hItr)->underflow();
-	refs[i]->addContent(uBin.numEntries(), uBin.sumW(), uBin.sumW2(),
-	  uBin.sumWY());
+	boot.addContent(refIndex(), i, uBin.numEntries(), uBin.sumW(),
+	  uBin.sumW2(), uBin.sumWY());
       } // End loop of bootstrapped correlators.
 
     }
@@ -546,14 +634,21 @@ namespace Rivet {
       return index;
     }
 
+    // @brief Index of the reference flow in the bootstrap accumulator,
+    // which is also the number of bins.
+    size_t refIndex() const {
+      return binX.size() - 1;
+    }
+
     // The harmonics vectors.
     vector<int> h1;
     vector<int> h2;
     // The bins.
     vector<double> binX;
-    vector<CorBin> binContent;
-    // The reference flow.
-    CorBin reference;
+    // The bootstrapped bin contents, with the reference flow last.
+    CorBootstrap boot;
+    // The bins handed out by getBinPtrs.
+    vector<CorBin> binView;
     // The profile histograms associated with the CorBins for streaming.
     list<Profile1DPtr> profs;
 
@@ -667,7 +762,11 @@ namespace Rivet {
 
     // @brief Constructor. Use CumulantAnalysis as base class for the
     // analysis to have access to functionality.
-    CumulantAnalysis (string n) : Analysis(n), errorMethod(VARIANCE) {};
+    // The correlators are kept outside the analysis objects, so the
+    // run cannot be resumed from a checkpoint.
+    CumulantAnalysis (string n) : Analysis(n), errorMethod(VARIANCE) {
+      declareUncheckpointed("Correlators");
+    };
     // @brief Helper method for turning correlators into Scatter2Ds.
     // Takes @parm h a pointer to the resulting Scatter2D, @parm binx
     // the x-bins and a function @parm func defining the transformation.
@@ -511,10 +511,158 @@ namespace Rivet {
   /// @name Isolation helper routines
   //@{
 
+  /// @brief Index of a collection's (rapidity, phi, pT) values for fast Delta R searches
+  ///
+  /// The rapidities (or pseudorapidities), azimuthal angles and pTs of the
+  /// collection are computed once, and the entries sorted in phi, so that a
+  /// cone search only visits the entries in a phi window around its axis
+  /// rather than the whole collection. Search results refer to positions in
+  /// the original collection, in their original order.
+  ///
+  /// Typical use is isolation, where a cone sum around each lepton over the
+  /// whole final state is needed:
+  /// @code
+  /// const DeltaRIndex fsidx(fsparticles);
+  /// const vector<double> conepts = fsidx.sumPts(leptons, 0.3);
+  /// @endcode
+  class DeltaRIndex {
+  public:
+
+    /// Build the index from any container of ParticleBase-derived objects
+    template <typename PBCONTAINER>
+    DeltaRIndex(const PBCONTAINER& pbs, RapScheme scheme=PSEUDORAPIDITY)
+      : _scheme(scheme)
+    {
+      _entries.reserve(pbs.size());
+      size_t i = 0;
+      for (const ParticleBase& pb : pbs) {
+        const FourMomentum& p = pb.mom();
+        _entries.push_back({_rap(p), p.phi(ZERO_2PI), p.pT(), i++});
+      }
+      std::sort(_entries.begin(), _entries.end(),
+                [](const Entry& a, const Entry& b) { return a.phi < b.phi; });
+    }
+
+    /// Number of indexed objects
+    size_t size() const { return _entries.size(); }
+
+
+    /// Positions of the indexed objects within @a dR of the direction (@a rap, @a phi)
+    vector<size_t> within(double rap, double phi, double dR) const {
+      vector<size_t> rtn;
+      _visit(rap, phi, dR, [&](const Entry& e) { rtn.push_back(e.index); return false; });
+      std::sort(rtn.begin(), rtn.end());
+      return rtn;
+    }
+
+    /// Positions of the indexed objects within @a dR of @a pb
+    vector<size_t> within(const ParticleBase& pb, double dR) const {
+      return within(_rap(pb.mom()), pb.phi(), dR);
+    }
+
+    /// Is any indexed object within @a dR of @a pb?
+    bool anyWithin(const ParticleBase& pb, double dR) const {
+      bool found = false;
+      _visit(_rap(pb.mom()), pb.phi(), dR, [&](const Entry&) { found = true; return true; });
+      return found;
+    }
+
+    /// For each object in @a centres, is any indexed object within @a dR of it?
+    ///
+    /// @note Disabled for single objects, which would otherwise pick this
+    /// overload rather than the ParticleBase one.
+    template <typename PBCONTAINER>
+    typename std::enable_if<!std::is_base_of<ParticleBase, PBCONTAINER>::value, vector<bool> >::type
+    anyWithin(const PBCONTAINER& centres, double dR) const {
+      vector<bool> rtn;
+      rtn.reserve(centres.size());
+      for (const ParticleBase& pb : centres) rtn.push_back(anyWithin(pb, dR));
+      return rtn;
+    }
+
+    /// Scalar sum of the pTs of the indexed objects within @a dR of @a pb
+    ///
+    /// @note If @a pb is itself in the index, its own pT is included.
+    double sumPt(const ParticleBase& pb, double dR) const {
+      double sum = 0;
+      _visit(_rap(pb.mom()), pb.phi(), dR, [&](const Entry& e) { sum += e.pT; return false; });
+      return sum;
+    }
+
+    /// Cone pT sums of the indexed objects around each object in @a centres
+    template <typename PBCONTAINER>
+    vector<double> sumPts(const PBCONTAINER& centres, double dR) const {
+      vector<double> rtn;
+      rtn.reserve(centres.size());
+      for (const ParticleBase& pb : centres) rtn.push_back(sumPt(pb, dR));
+      return rtn;
+    }
+
+
+  private:
+
+    struct Entry {
+      double rap, phi, pT;
+      size_t index;
+    };
+
+    double _rap(const FourMomentum& p) const {
+      return _scheme == RAPIDITY ? p.rapidity() : p.eta();
+    }
+
+    /// Call @a fn on every entry within @a dR of (@a rap, @a phi), until it returns true
+    template <typename FN>
+    void _visit(double rap, double phi, double dR, const FN& fn) const {
+      if (_entries.empty()) return;
+      phi = mapAngle0To2Pi(phi);
+      auto visitRange = [&](double phimin, double phimax) {
+        auto it = std::lower_bound(_entries.begin(), _entries.end(), phimin,
+                                   [](const Entry& e, double x) { return e.phi < x; });
+        for (; it != _entries.end() && it->phi <= phimax; ++it)
+          if (deltaR(rap, phi, it->rap, it->phi) < dR && fn(*it)) return true;
+        return false;
+      };
+      // The whole phi range has to be searched for large cones. The window is
+      // padded slightly so rounding can't exclude entries on its edge.
+      const double dphi = dR + 1e-9;
+      if (dphi >= PI) {
+        visitRange(0, TWOPI);
+        return;
+      }
+      // Otherwise search the phi window, split in two where it wraps around
+      const double phimin = phi - dphi, phimax = phi + dphi;
+      if (phimin < 0) {
+        if (visitRange(phimin + TWOPI, TWOPI)) return;
+        visitRange(0, phimax);
+      } else if (phimax > TWOPI) {
+        if (visitRange(phimin, TWOPI)) return;
+        visitRange(0, phimax - TWOPI);
+      } else {
+        visitRange(phimin, phimax);
+      }
+    }
+
+    RapScheme _scheme;
+
+    vector<Entry> _entries;
+
+  };
+
+
+  /// @brief Cone pT sums around each of @a centres, over all of @a particles
+  ///
+  /// Builds a DeltaRIndex of @a particles once and queries it for every centre.
+  template<typename PBCONTAINER1, typename PBCONTAINER2>
+  vector<double> coneSumPts(const PBCONTAINER1& centres, const PBCONTAINER2& particles, double dR) {
+    return DeltaRIndex(particles).sumPts(centres, dR);
+  }
+
+
   template<typename PBCONTAINER1, typename PBCONTAINER2>
   void idiscardIfAnyDeltaRLess(PBCONTAINER1& tofilter, const PBCONTAINER2& tocompare, double dR) {
-    for (const ParticleBase& pb : tocompare)
-      ifilter_discard(tofilter, deltaRLess(pb, dR));
+    if (tofilter.empty() || tocompare.empty()) return;
+    const DeltaRIndex idx(tocompare);
+    ifilter_discard(tofilter, [&](const ParticleBase& pb) { return idx.anyWithin(pb, dR); });
   }
 
   template<typename PBCONTAINER1, typename PBCONTAINER2>
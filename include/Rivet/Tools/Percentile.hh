@@ -4,6 +4,7 @@
 #include "Rivet/Event.hh"
 #include "Rivet/Projections/CentralityProjection.hh"
 #include "Rivet/ProjectionApplier.hh"
+#include <cstdio>
 
 namespace Rivet {
 
@@ -11,6 +12,158 @@ namespace Rivet {
 /// Forward declaration.
 class Analysis;
 
+/// @brief Journal of the events seen by a Percentile without calibration.
+///
+/// If the CentralityProjection of a Percentile has no calibration
+/// histogram, the value of the centrality estimator and the weights of
+/// each event, together with the arguments of all fills made through
+/// the Percentile, are spilled to a temporary binary file. At the end
+/// of the run the percentile table is derived from the journaled
+/// estimator values and the events are replayed into the right
+/// centrality bins, so that no separate calibration run is needed.
+class PercentileJournal {
+
+public:
+
+  /// A function filling the AnalysisObjects of the active bins with
+  /// the recorded fill arguments.
+  typedef function<void(const vector<int> &, const double *)> Replayer;
+
+  /// Constructor taking the centrality bins and the direction of the
+  /// estimator.
+  PercentileJournal(const vector<pair<float, float> > & cent, bool increasing)
+    : _cent(cent), _increasing(increasing), _recording(true), _file(nullptr) {}
+
+  /// Destructor removing the spill file.
+  ~PercentileJournal() {
+    if ( _file ) fclose(_file);
+  }
+
+  /// Is the journal still recording, ie. waiting for its calibration?
+  bool recording() const { return _recording; }
+
+  /// Have the AnalysisObjects to replay into been given?
+  bool hasAnalysisObjects() const { return !_aos.empty(); }
+
+  /// Set the AnalysisObjects to replay into, and the function
+  /// counting the events in the active bins.
+  void setAnalysisObjects(const vector<MultiweightAOPtr> & aos,
+                          function<void(const vector<int> &)> count) {
+    _aos = aos;
+    _count = count;
+  }
+
+  /// Record a new (sub-)event with centrality estimator value @a est.
+  void beginEvent(const Event & ev, double est) {
+    beginEvent(ev.genEvent()->event_number(), ev.weights(), est);
+  }
+
+  /// Record a new (sub-)event with event number @a evtnum and
+  /// weights @a weights, and centrality estimator value @a est.
+  void beginEvent(int64_t evtnum, const valarray<double> & weights, double est);
+
+  /// Record a fill with @a nargs arguments.
+  void addFill(const double * args, size_t nargs);
+
+  /// Is there a function to replay fills with @a nargs arguments?
+  bool hasReplayer(size_t nargs) const {
+    return nargs < _replayers.size() && _replayers[nargs];
+  }
+
+  /// Set the function to replay fills with @a nargs arguments.
+  void setReplayer(size_t nargs, Replayer r) {
+    if ( _replayers.size() <= nargs ) _replayers.resize(nargs + 1);
+    _replayers[nargs] = r;
+  }
+
+  /// Derive the percentile table from the journaled estimator values,
+  /// using the weights with index @a nominal, and replay the journal
+  /// into the AnalysisObjects.
+  void replay(size_t nominal);
+
+  /// The percentile corresponding to the estimator value @a est, once
+  /// calibrated.
+  double percentile(double est) const;
+
+  /// The contents of the spill file, for a checkpoint of the run.
+  /// Empty if the journal is no longer recording.
+  string spill() const;
+
+  /// Continue the journal from the spill file contents @a data saved
+  /// by spill().
+  void restore(const string & data);
+
+private:
+
+  /// Make sure the spill file is open.
+  void _open();
+
+  /// The centrality bins of the Percentile.
+  vector<pair<float, float> > _cent;
+
+  /// Do low estimator values correspond to low percentiles?
+  bool _increasing;
+
+  /// Are we still journaling events?
+  bool _recording;
+
+  /// The spill file.
+  FILE * _file;
+
+  /// The AnalysisObjects and event counters of the Percentile.
+  vector<MultiweightAOPtr> _aos;
+
+  /// The function counting events in the active bins.
+  function<void(const vector<int> &)> _count;
+
+  /// The fill replay functions indexed by number of arguments.
+  vector<Replayer> _replayers;
+
+  /// The (interpolated) lookup table from estimator value to percentile.
+  map<double, double> _table;
+
+};
+
+/// @brief Helper to replay a fill with @a N recorded arguments.
+template <size_t N>
+struct PercentileFillReplay;
+
+template <>
+struct PercentileFillReplay<0> {
+  template <typename P>
+  static void fill(P & ao, const double *) { ao->fill(); }
+};
+
+template <>
+struct PercentileFillReplay<1> {
+  template <typename P>
+  static void fill(P & ao, const double * a) { ao->fill(a[0]); }
+};
+
+template <>
+struct PercentileFillReplay<2> {
+  template <typename P>
+  static void fill(P & ao, const double * a) { ao->fill(a[0], a[1]); }
+};
+
+template <>
+struct PercentileFillReplay<3> {
+  template <typename P>
+  static void fill(P & ao, const double * a) { ao->fill(a[0], a[1], a[2]); }
+};
+
+template <>
+struct PercentileFillReplay<4> {
+  template <typename P>
+  static void fill(P & ao, const double * a) { ao->fill(a[0], a[1], a[2], a[3]); }
+};
+
+template <>
+struct PercentileFillReplay<5> {
+  template <typename P>
+  static void fill(P & ao, const double * a) { ao->fill(a[0], a[1], a[2], a[3], a[4]); }
+};
+
 /// @brief PercentileBase is the base class of all Percentile classes.
 ///
 /// This base class contains all non-templated variables and
@@ -63,6 +216,11 @@ public:
     return _cent;
   }
 
+  /// @brief Are events being journaled for a later calibration?
+  bool journaling() const {
+    return _journal && _journal->recording();
+  }
+
 protected:
 
   /// The Analysis object to which This object is assigned.
@@ -79,6 +237,9 @@ protected:
   /// object.
   vector<pair<float, float> > _cent;
 
+  /// The journal used if the CentralityProjection is not calibrated.
+  shared_ptr<PercentileJournal> _journal;
+
 };
 
 /// @brief PercentileTBase is the base class of all Percentile classes.
@@ -140,6 +301,20 @@ public:
   /// events seen for each centrality bin and AnalysisAbject.
   bool init(const Event & event) { 
     selectBins(event);
+    if ( journaling() ) {
+      if ( !_journal->hasAnalysisObjects() ) {
+        vector<MultiweightAOPtr> aos;
+        for ( const auto & hist : _histos ) {
+          aos.push_back(hist.first);
+          aos.push_back(hist.second);
+        }
+        vector<pair<TPtr, CounterPtr> > histos = _histos;
+        _journal->setAnalysisObjects(aos, [histos](const vector<int> & active) mutable {
+            for ( const auto bin : active ) histos[bin].second->fill();
+          });
+      }
+      return true;
+    }
     for (const auto bin : _activeBins)
       _histos[bin].second->fill();
     return !_activeBins.empty();
@@ -183,6 +358,28 @@ protected:
   /// active.
   vector<pair<TPtr, CounterPtr > > _histos;
 
+  /// @brief Journal a fill with arguments @a args.
+  ///
+  /// If @a XA is 1 the replayed fill gets the bin index prepended, as
+  /// for PercentileXaxis.
+  template <size_t XA, typename... Args>
+  void _journalFill(Args... args) {
+    const size_t N = sizeof...(Args);
+    const double a[] = { 0.0, double(args)... };
+    if ( !_journal->hasReplayer(N) ) {
+      vector<pair<TPtr, CounterPtr> > histos = _histos;
+      _journal->setReplayer(N, [histos](const vector<int> & active, const double * rec) mutable {
+          double b[N + XA + 1];
+          std::copy(rec, rec + N, b + XA);
+          for ( const auto bin : active ) {
+            if ( XA ) b[0] = bin;
+            PercentileFillReplay<N + XA>::fill(histos[bin].first, b);
+          }
+        });
+    }
+    _journal->addFill(a + 1, N);
+  }
+
 };
 
 /// @brief The Percentile class for centrality binning.
@@ -222,6 +419,10 @@ public:
   /// PercentileTBase<T>init
   template<typename... Args>
   void fill(Args... args) {
+    if ( this->journaling() ) {
+      this->template _journalFill<0>(args...);
+      return;
+    }
     for (const auto bin : _activeBins) {
       _histos[bin].first->fill(args...);
     }
@@ -295,6 +496,10 @@ public:
   /// PercentileTBase<T>init
   template<typename... Args>
   void fill(Args... args) {
+    if ( this->journaling() ) {
+      this->template _journalFill<1>(args...);
+      return;
+    }
     for (const auto bin : _activeBins) {
       _histos[bin].first->fill(bin, args...);
     }
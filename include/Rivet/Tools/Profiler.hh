@@ -0,0 +1,127 @@
+// -*- C++ -*-
+#ifndef RIVET_Profiler_HH
+#define RIVET_Profiler_HH
+
+#include "Rivet/Tools/RivetSTL.hh"
+#include <chrono>
+
+namespace Rivet {
+
+
+  // Forward declaration
+  class Projection;
+
+
+  /// @brief Wall-clock profiler for analyses and projections
+  ///
+  /// Records call counts and cumulative time for each analysis, and for each
+  /// projection instance the number of executions, the number of cache hits
+  /// and the names of the analyses which use it. A shared projection's time
+  /// is only counted once, by the first analysis that triggers it in each
+  /// event, but all its users are listed. Projection times are inclusive of
+  /// any projections they apply themselves.
+  ///
+  /// Profiling is switched off by default, and then costs a single flag check
+  /// per projection call. It is enabled by AnalysisHandler::profile() or by
+  /// setting the RIVET_PROFILE environment variable.
+  class Profiler {
+  public:
+
+    /// Accumulated statistics for one analysis or projection
+    struct Record {
+      string name;
+      size_t calls = 0;
+      size_t hits = 0;
+      size_t fills = 0;
+      double seconds = 0.0;
+      set<string> users;
+    };
+
+    /// Constructor
+    Profiler() { reset(); }
+
+    /// The process-wide profiler
+    static Profiler& global();
+
+    /// Current time in seconds, for use as a start-time in the record methods
+    static double clock() {
+      using namespace std::chrono;
+      return duration<double>(steady_clock::now().time_since_epoch()).count();
+    }
+
+
+    /// @name Control
+    //@{
+
+    /// Is profiling switched on?
+    bool enabled() const { return _enabled; }
+
+    /// Switch profiling on or off
+    void setEnabled(bool enable=true) { _enabled = enable; }
+
+    /// Discard all recorded statistics
+    void reset();
+
+    /// Set the name of the analysis currently being run
+    void setCurrentAnalysis(const string& ananame) { _current = ananame; }
+
+    //@}
+
+
+    /// @name Recording
+    //@{
+
+    /// Record one call of an analysis' analyze method started at @a t0
+    void analysisCall(const string& ananame, double t0);
+
+    /// Record @a nfills histogram fills made by an analysis
+    void analysisFills(const string& ananame, size_t nfills);
+
+    /// Record one execution of the projection @a p started at @a t0
+    void projectionCall(const Projection& p, double t0);
+
+    /// Record one cache hit for the projection @a p
+    void projectionHit(const Projection& p);
+
+    /// Record one call of AnalysisHandler::pushToPersistent started at @a t0
+    void pushCall(double t0);
+
+    //@}
+
+
+    /// @name Reports
+    //@{
+
+    /// Write a human-readable summary table, slowest entries first
+    void writeText(std::ostream& os) const;
+
+    /// Write all records as a JSON document
+    void writeJSON(std::ostream& os) const;
+
+    /// Write the text and JSON reports to @a basename.txt and @a basename.json
+    void writeReports(const string& basename) const;
+
+    //@}
+
+
+  private:
+
+    /// Get the record for @a p, creating it if needed
+    Record& _projRecord(const Projection& p);
+
+    bool _enabled = false;
+
+    string _current;
+
+    map<string, Record> _analyses;
+
+    map<const Projection*, Record> _projections;
+
+    Record _push;
+
+  };
+
+
+}
+
+#endif
@@ -17,6 +17,7 @@
 #include "Rivet/Tools/RivetHepMC.hh"
 #include "HepMC3/Reader.h"
 #include "HepMC3/GenEvent.h"
+#include "HepMC3/Data/GenEventData.h"
 #include <string>
 #include <fstream>
 #include <istream>
@@ -114,16 +115,21 @@ private:
 
   /// @brief Read position information
   ///
-  /// Reads position information from the current line and sets the
-  /// information in the given vertex. If no vertex is given the root
-  /// vertiex is assumed.
-  bool read_position(GenVertexPtr v = GenVertexPtr());
+  /// Reads position information, if any, from the current line into
+  /// @a pos.
+  bool read_position(HepMC3::FourVector& pos);
 
   /// @brief Read momentum information
   ///
   /// Reads momentum and mass information from the current line and
-  /// sets the information in the given particle.
-  bool read_momentum(GenParticlePtr p);
+  /// sets the information in the given particle data.
+  bool read_momentum(HepMC3::GenParticleData& p);
+
+  /// @brief Build the event from the decoded tables
+  ///
+  /// Orders the vertices, resolves the particle-vertex links, and
+  /// creates all particles and vertices in one go.
+  void build_event(GenEvent& evt);
 
   //@}
 
@@ -134,6 +140,7 @@ private:
   std::istream* m_stream;     //!< The stream being read from 
 
   std::istringstream is;      //!< A stream to read from the current line.
+  const char* m_cur;          //!< Read position in the current line.
 
   GenEvent * m_evt;           //!< The event being read in.
   
@@ -145,14 +152,18 @@ private:
 
   map<long,long> m_masses;    //!< Keep track of masses being read.
 
-  /// Keep track of read particles
-  vector<GenParticlePtr>  m_particles;
-  /// Keep track of read particles
-  vector<int>  m_ppvx;
+  /// The event being read, as flat particle and vertex tables
+  HepMC3::GenEventData m_data;
+  /// Production vertex of each read particle (minus the vertex id)
+  vector<int> m_ppvx;
+  /// Minus the id of each read vertex
+  vector<int> m_vkeys;
   /// Keep track of read vertices
-  map<int,GenVertexPtr> m_vertices;
-  /// Keep track of incoming particles to vertices
-  map<int, std::vector<int> > m_vpin;
+  vector<HepMC3::GenVertexData> m_vdata;
+  /// Incoming particles of all read vertices, one after the other
+  vector<int> m_vpin;
+  /// Start of the incoming particles of each read vertex in m_vpin
+  vector<size_t> m_vpinbegin;
 
   /** @brief Store attributes global to the run being written/read. */
   std::map< std::string, shared_ptr<HepMC3::Attribute> > m_global_attributes;
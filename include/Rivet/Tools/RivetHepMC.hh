@@ -89,6 +89,7 @@ namespace Rivet {
     std::vector<ConstGenParticlePtr> particles(ConstGenVertexPtr gv, const Relatives &relo);
     std::vector<ConstGenParticlePtr> particles(ConstGenParticlePtr gp, const Relatives &relo);
     int uniqueId(ConstGenParticlePtr gp);
+    int uniqueId(ConstGenVertexPtr gv);
     int particles_size(ConstGenEventPtr ge);
     int particles_size(const GenEvent *ge);
     std::pair<ConstGenParticlePtr,ConstGenParticlePtr> beams(const GenEvent *ge);
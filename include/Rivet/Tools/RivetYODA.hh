@@ -12,7 +12,9 @@
 #include "YODA/Scatter2D.h"
 #include "YODA/Scatter3D.h"
 
+#include <atomic>
 #include <map>
+#include <mutex>
 #include <valarray>
 
 namespace YODA {
@@ -136,16 +138,76 @@ namespace Rivet {
   */
 
 
+  /// @brief Striped locks over the weight variations of a shared persistent store
+  ///
+  /// Several threads can commit events into the same per-weight objects by
+  /// locking one contiguous shard of weight indices at a time. Each commit
+  /// starts on a different shard, so concurrent commits mostly touch
+  /// disjoint variations, and the store is shared instead of being
+  /// replicated per thread.
+  class WeightShardLocks {
+  public:
+
+    /// Locks for @a nweights variations, split into at most @a nshards shards
+    WeightShardLocks(size_t nweights, size_t nshards=16)
+      : _nweights(nweights),
+        _shardsize(max<size_t>(1, (nweights + nshards - 1)/max<size_t>(1, nshards))),
+        _mutexes(max<size_t>(1, (nweights + _shardsize - 1)/_shardsize))
+    { }
+
+    /// Call @a fn(mlo, mhi) for each shard [mlo, mhi) of weight indices, holding its lock
+    template <typename FN>
+    void forEachShard(FN fn) {
+      const size_t nshards = _mutexes.size();
+      const size_t first = _next++ % nshards;
+      for (size_t i = 0; i < nshards; ++i) {
+        const size_t s = (first + i) % nshards;
+        const size_t mlo = s*_shardsize;
+        const size_t mhi = min(_nweights, mlo + _shardsize);
+        if (mlo >= mhi) continue;
+        std::lock_guard<std::mutex> lock(_mutexes[s]);
+        fn(mlo, mhi);
+      }
+    }
+
+  private:
+
+    size_t _nweights, _shardsize;
+    vector<std::mutex> _mutexes;
+    std::atomic<size_t> _next{0};
+
+  };
+
+
   class MultiweightAOWrapper : public AnalysisObjectWrapper {
 
   public:
     using Inner = YODA::AnalysisObject;
 
+    /// @brief Make a wrapper committing into the same persistent objects
+    ///
+    /// The replica has its own event-group fill buffers, so each
+    /// event-processing thread can fill and push its own replica while
+    /// all of them accumulate into one shared store. Commits are then
+    /// serialised per weight shard. Replicas must be made before any
+    /// concurrent pushToPersistent calls.
+    ///
+    /// @note Only newSubEvent() and pushToPersistent() may be called
+    /// concurrently. The final-object path (pushToFinal() and the
+    /// finalize-time active pointers) is single-threaded: it is only
+    /// available on the original wrapper, once all replicas have committed.
+    virtual shared_ptr<MultiweightAOWrapper> mkThreadReplica() = 0;
+
     virtual void newSubEvent() = 0;
 
     virtual void pushToPersistent(const vector<std::valarray<double> >& weight) = 0;
+
+    /// Copy the persistent objects to the final ones (single-threaded, not on replicas)
     virtual void pushToFinal() = 0;
 
+    /// Number of fills recorded in the current event group
+    virtual size_t numFills() const = 0;
+
     virtual YODA::AnalysisObjectPtr activeYODAPtr() const = 0;
 
     virtual string basePath() const = 0;
@@ -157,8 +219,13 @@ namespace Rivet {
   template <class T>
   using Fill = pair<typename T::FillType, Weight>;
 
+  /// @brief Append-only record of the fills in one sub-event
+  ///
+  /// Clearing keeps the allocated capacity, so after the first few events
+  /// recording fills needs no further allocations. The fills are kept in
+  /// the order they were made, and only sorted when sub-events are matched.
   template <class T>
-  using Fills = multiset<Fill<T>>;
+  using Fills = vector<Fill<T>>;
 
 
   // TODO TODO TODO
@@ -179,7 +246,7 @@ namespace Rivet {
     // todo: do we need to deal with users using fractions directly?
     void fill( double weight=1.0, double fraction=1.0 ) {
       (void)fraction;
-      fills_.insert( {YODA::Counter::FillType(),weight} );
+      fills_.push_back( {YODA::Counter::FillType(),weight} );
     }
     void reset() { fills_.clear(); }
     const Fills<YODA::Counter> & fills() const { return fills_; }
@@ -197,7 +264,7 @@ namespace Rivet {
     void fill( double x, double weight=1.0, double fraction=1.0 ) {
       (void)fraction;
       if ( std::isnan(x) ) throw YODA::RangeError("X is NaN");
-      fills_.insert( { x , weight } );
+      fills_.push_back( { x , weight } );
     }
     void reset() { fills_.clear(); }
     const Fills<YODA::Histo1D> & fills() const { return fills_; }
@@ -216,7 +283,7 @@ namespace Rivet {
       (void)fraction;
       if ( std::isnan(x) ) throw YODA::RangeError("X is NaN");
       if ( std::isnan(y) ) throw YODA::RangeError("Y is NaN");
-      fills_.insert( { YODA::Profile1D::FillType{x,y}, weight } );
+      fills_.push_back( { YODA::Profile1D::FillType{x,y}, weight } );
     }
     void reset() { fills_.clear(); }
     const Fills<YODA::Profile1D> & fills() const { return fills_; }
@@ -236,7 +303,7 @@ namespace Rivet {
       (void)fraction;
       if ( std::isnan(x) ) throw YODA::RangeError("X is NaN");
       if ( std::isnan(y) ) throw YODA::RangeError("Y is NaN");
-      fills_.insert( { YODA::Histo2D::FillType{x,y}, weight } );
+      fills_.push_back( { YODA::Histo2D::FillType{x,y}, weight } );
     }
     void reset() { fills_.clear(); }
     const Fills<YODA::Histo2D> & fills() const { return fills_; }
@@ -256,7 +323,7 @@ namespace Rivet {
       if ( std::isnan(x) ) throw YODA::RangeError("X is NaN");
       if ( std::isnan(y) ) throw YODA::RangeError("Y is NaN");
       if ( std::isnan(z) ) throw YODA::RangeError("Z is NaN");
-      fills_.insert( { YODA::Profile2D::FillType{x,y,z}, weight } );
+      fills_.push_back( { YODA::Profile2D::FillType{x,y,z}, weight } );
     }
     void reset() { fills_.clear(); }
     const Fills<YODA::Profile2D> & fills() const { return fills_; }
@@ -309,6 +376,8 @@ namespace Rivet {
 
     typename T::Ptr active() const;
 
+    shared_ptr<MultiweightAOWrapper> mkThreadReplica();
+
     /* @todo this probably need to loop over all? */
     bool operator!() const { return !_active; } // Don't use active() here, assert will catch
 
@@ -377,6 +446,8 @@ namespace Rivet {
     }
 
     void setActiveFinalWeightIdx(unsigned int iWeight) {
+      assert(!_replica && "Thread replicas have no final objects");
+      if ( _final.size() != _persistent.size() ) pushToFinal();
       _active = _final.at(iWeight);
     }
 
@@ -396,16 +467,29 @@ namespace Rivet {
     void pushToPersistent(const vector<std::valarray<double> >& weight);
     void pushToFinal();
 
+    size_t numFills() const;
+
 
     /* M of these, one for each weight */
     vector<typename T::Ptr> _persistent;
 
-    /* This is the copy of _persistent that will be passed to finalize(). */
+    /* This is the copy of _persistent that will be passed to finalize().
+       It is only created by the first pushToFinal(). */
     vector<typename T::Ptr> _final;
 
-    /* N of these, one for each event in evgroup */
+    /* Shard locks for _persistent, only set once it is shared with thread replicas. */
+    shared_ptr<WeightShardLocks> _locks;
+
+    /* Is this a thread replica, sharing _persistent but without any _final? */
+    bool _replica = false;
+
+    /* N of these, one for each event in evgroup. Only the first _nsubevents
+     * are in use: the rest are kept from earlier event groups for re-use, to
+     * avoid cloning the binning for every event. */
     vector<typename TupleWrapper<T>::Ptr> _evgroup;
 
+    size_t _nsubevents = 0;
+
     typename T::Ptr _active;
 
     string basePath() const { return _basePath; }
@@ -534,6 +618,13 @@ namespace Rivet {
   /// given @a papername.
   map<string, YODA::AnalysisObjectPtr> getRefData(const string& papername);
 
+  /// @brief Function to get the single refdata object @a hname in a paper with
+  /// the given @a papername, or a null pointer if there is no such object.
+  ///
+  /// Reference files are read once per process, and only the requested
+  /// objects are parsed. The returned object is shared: treat it as read-only.
+  YODA::AnalysisObjectPtr getRefDataObject(const string& papername, const string& hname);
+
   /// @todo Also provide a Scatter3D getRefData() version?
 
   /// Get the file system path to the reference file for this paper.
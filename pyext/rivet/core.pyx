@@ -48,6 +48,12 @@ cdef class AnalysisHandler:
     def writeData(self, name):
         self._ptr.writeData(name.encode('utf-8'))
 
+    def writeCheckpoint(self, name, inputoffset=0):
+        self._ptr.writeCheckpoint(name.encode('utf-8'), inputoffset)
+
+    def readCheckpoint(self, name):
+        return self._ptr.readCheckpoint(name.encode('utf-8'))
+
     def nominalCrossSection(self):
         return self._ptr.nominalCrossSection()
 
@@ -57,6 +63,9 @@ cdef class AnalysisHandler:
     def dump(self, name, period):
         self._ptr.dump(name.encode('utf-8'), period)
 
+    def profile(self, name):
+        self._ptr.profile(name.encode('utf-8'))
+
     def mergeYodas(self, filelist, delopts, equiv):
         self._ptr.mergeYodas(filelist, delopts, equiv)
 
@@ -93,6 +102,21 @@ cdef class Run:
     def processEvent(self):
         return self._ptr.processEvent()
 
+    def skipEvents(self, size_t n):
+        cdef size_t nskipped
+        with nogil:
+            nskipped = self._ptr.skipEvents(n)
+        return nskipped
+
+    def processEvents(self, size_t n, unsigned int evttimeout=0):
+        cdef size_t nprocessed
+        with nogil:
+            nprocessed = self._ptr.processEvents(n, evttimeout)
+        return nprocessed
+
+    def eventFailed(self):
+        return self._ptr.eventFailed()
+
     def finalize(self):
         return self._ptr.finalize()
 
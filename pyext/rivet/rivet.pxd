@@ -18,9 +18,12 @@ cdef extern from "Rivet/AnalysisHandler.hh" namespace "Rivet":
         # Analysis* analysis(string)
         void writeData(string&)
         void readData(string&)
+        void writeCheckpoint(string&, size_t) except +
+        size_t readCheckpoint(string&) except +
         double nominalCrossSection()
         void finalize()
         void dump(string, int)
+        void profile(string)
         void mergeYodas(vector[string], vector[string], bool)
 
 cdef extern from "Rivet/Run.hh" namespace "Rivet":
@@ -33,6 +36,9 @@ cdef extern from "Rivet/Run.hh" namespace "Rivet":
         bool readEvent() except +
         bool skipEvent() except +
         bool processEvent() except +
+        size_t skipEvents(size_t) nogil except +
+        size_t processEvents(size_t, unsigned int) nogil except +
+        bool eventFailed()
         bool finalize() except +
 
 cdef extern from "Rivet/Analysis.hh" namespace "Rivet":
@@ -196,10 +196,10 @@ namespace Rivet {
   // Histogramming
 
 
-  void Analysis::_cacheRefData() const {
-    if (_refdata.empty()) {
-      MSG_TRACE("Getting refdata cache for paper " << name());
-      _refdata = getRefData(getRefDataName());
+  void Analysis::_cacheRefData(const string& hname) const {
+    if (_refdata.find(hname) == _refdata.end()) {
+      MSG_TRACE("Getting refdata " << hname << " for paper " << name());
+      _refdata[hname] = getRefDataObject(getRefDataName(), hname);
     }
   }
 
@@ -630,6 +630,14 @@ namespace Rivet {
   /////////////////////
 
 
+  void Analysis::_replayJournals() {
+    for (auto j : _journals) {
+      MSG_DEBUG("Calibrating centrality from the journaled events of this run");
+      j->replay(_defaultWeightIndex());
+    }
+  }
+
+
   void Analysis::divide(CounterPtr c1, CounterPtr c2, Scatter1DPtr s) const {
     const string path = s->path();
     *s = *c1 / *c2;
@@ -893,10 +901,8 @@ Analysis::declareCentrality(const SingleValueProjection &proj,
   set<string> done;
 
   if ( sel == "REF" ) {
-    YODA::Scatter2DPtr refscat;
-    auto refmap = getRefData(calAnaName);
-    if ( refmap.find(calHistName) != refmap.end() )
-      refscat = dynamic_pointer_cast<Scatter2D>(refmap.find(calHistName)->second);
+    YODA::Scatter2DPtr refscat =
+      dynamic_pointer_cast<Scatter2D>(getRefDataObject(calAnaName, calHistName));
 
     if ( !refscat ) {
       MSG_WARNING("No reference calibration histogram for " <<
@@ -920,7 +926,9 @@ Analysis::declareCentrality(const SingleValueProjection &proj,
       MSG_WARNING("No generated calibration histogram for " <<
                "CentralityProjection " << projName << " found " <<
                "(requested histogram " << calHistName << " in " <<
-               calAnaName << ")");
+               calAnaName << "): only Percentile objects are calibrated, from "
+               << "the events of this run, and the projection itself gives -1");
+      cproj.add(PercentileProjection(proj, increasing), sel);
     }
     else {
       MSG_INFO("Found calibration histogram " << sel << " " << genhists->path());
@@ -934,7 +942,9 @@ Analysis::declareCentrality(const SingleValueProjection &proj,
       MSG_WARNING("No impact parameter calibration histogram for " <<
                "CentralityProjection " << projName << " found " <<
                "(requested histogram " << calHistName << "_IMP in " <<
-               calAnaName << ")");
+               calAnaName << "): only Percentile objects are calibrated, from "
+               << "the events of this run, and the projection itself gives -1");
+      cproj.add(PercentileProjection(ImpactParameterProjection(), true), sel);
     }
     else {
       MSG_INFO("Found calibration histogram " << sel << " " << imphists->path());
@@ -992,6 +1002,10 @@ Analysis::declareCentrality(const SingleValueProjection &proj,
     return handler().defaultWeightIndex();
   }
 
+  string Analysis::_getJournalPreload(size_t i) const {
+    return handler().getJournalPreload(name(), i);
+  }
+
   MultiweightAOPtr Analysis::_getOtherAnalysisObject(const std::string & ananame, const std::string& name) {
     std::string path = "/" + ananame + "/" + name;
     const auto& ana = handler().analysis(ananame);
@@ -5,9 +5,14 @@
 #include "Rivet/Tools/ParticleName.hh"
 #include "Rivet/Tools/BeamConstraint.hh"
 #include "Rivet/Tools/Logging.hh"
+#include "Rivet/Tools/Profiler.hh"
 #include "Rivet/Projections/Beam.hh"
+#include "Rivet/Projections/EventMixingFinalState.hh"
 #include "YODA/IO.h"
 #include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
 
 using std::cout;
 using std::cerr;
@@ -74,6 +79,14 @@ namespace Rivet {
     _eventNumber = ge.event_number();
 
     setWeightNames(ge);
+    _stripEvents = ( getEnvParam("RIVET_STRIP_HEPMC", string("NOOOO") ) != "NOOOO" );
+    if ( _profileFile.empty() ) _profileFile = getEnvParam("RIVET_PROFILE", string(""));
+    if ( !_profileFile.empty() ) {
+      MSG_INFO("Profiling analyses and projections: reports will be written to "
+               << _profileFile << ".txt and " << _profileFile << ".json");
+      Profiler::global().reset();
+      Profiler::global().setEnabled(true);
+    }
     if (_skipWeights)
         MSG_INFO("Only using nominal weight. Variation weights will be ignored.");
     else if (haveNamedWeights())
@@ -83,6 +96,19 @@ namespace Rivet {
 
     _eventCounter = CounterPtr(weightNames(), Counter("_EVTCOUNT"));
 
+    // Pick up the event counts of a run resumed from a checkpoint
+    if ( !_resumeWeightNames.empty() ) {
+      if ( _resumeWeightNames != _weightNames )
+        throw UserError("The event weights of this run differ from those in the checkpoint");
+      for (size_t iW = 0; iW < numWeights(); ++iW) {
+        _eventCounter.get()->setActiveWeightIdx(iW);
+        YODA::AnalysisObjectPtr ao = _eventCounter.get()->activeYODAPtr();
+        YODA::AnalysisObjectPtr preload = getPreload(ao->path());
+        if ( preload ) copyao(preload, ao);
+      }
+      _eventCounter.get()->unsetActiveWeight();
+    }
+
     // Set the cross section based on what is reported by this event.
     if ( ge.cross_section() ) setCrossSection(HepMCUtils::crossSection(ge));
 
@@ -133,7 +159,18 @@ namespace Rivet {
       MSG_DEBUG("Done initialising analysis: " << a->name());
     }
     _stage = Stage::OTHER;
+
+    // A resumed run cannot restore state kept outside the analysis objects
+    if ( !_resumeWeightNames.empty() ) {
+      for (AnaHandle a : analyses()) {
+        const string what = _uncheckpointed(a);
+        if ( !what.empty() )
+          throw UserError("Analysis '" + a->name() + "' keeps " + what +
+                          " outside its analysis objects: it cannot be resumed from a checkpoint");
+      }
+    }
     _initialised = true;
+    _collectAOs();
     MSG_DEBUG("Analysis handler initialised");
   }
 
@@ -163,12 +200,14 @@ namespace Rivet {
 
     // Create the Rivet event wrapper
     /// @todo Filter/normalize the event here
-    bool strip = ( getEnvParam("RIVET_STRIP_HEPMC", string("NOOOO") ) != "NOOOO" );
-    Event event(ge, strip);
+    Event event(ge, _stripEvents);
 
-    // set the cross section based on what is reported by this event.
-    // if no cross section
-    if ( ge.cross_section() ) setCrossSection(HepMCUtils::crossSection(ge));
+    // Record the cross section reported by this event. The per-weight
+    // _XSEC scatter is only rebuilt when it is next needed.
+    if ( ge.cross_section() ) {
+      _xsec = HepMCUtils::crossSection(ge);
+      _xsecDirty = true;
+    }
 
     // Won't happen for first event because _eventNumber is set in init()
     if (_eventNumber != ge.event_number()) {
@@ -182,12 +221,7 @@ namespace Rivet {
 
     MSG_TRACE("starting new sub event");
     _eventCounter.get()->newSubEvent();
-
-    for (const AnaHandle& a : analyses()) {
-        for (auto ao : a->analysisObjects()) {
-            ao.get()->newSubEvent();
-        }
-    }
+    for (const MultiweightAOPtr& ao : _rivetAOs) ao.get()->newSubEvent();
 
     _subEventWeights.push_back(event.weights());
     if (_weightCap != 0.) {
@@ -204,16 +238,22 @@ namespace Rivet {
 
     _eventCounter->fill();
     // Run the analyses
-    for (AnaHandle a : analyses()) {
+    Profiler& prof = Profiler::global();
+    for (const auto& apair : _analyses) {
+      const AnaHandle& a = apair.second;
       MSG_TRACE("About to run analysis " << a->name());
+      const double t0 = prof.enabled() ? Profiler::clock() : 0.0;
+      if ( prof.enabled() ) prof.setCurrentAnalysis(a->name());
       try {
         a->analyze(event);
       } catch (const Error& err) {
         cerr << "Error in " << a->name() << "::analyze method: " << err.what() << endl;
         exit(1);
       }
+      if ( prof.enabled() ) prof.analysisCall(a->name(), t0);
       MSG_TRACE("Finished running analysis " << a->name());
     }
+    if ( prof.enabled() ) prof.setCurrentAnalysis("");
 
     if ( _dumpPeriod > 0 && numEvents() > 0 && numEvents()%_dumpPeriod == 0 ) {
       MSG_DEBUG("Dumping intermediate results to " << _dumpFile << ".");
@@ -236,18 +276,24 @@ namespace Rivet {
 
   void AnalysisHandler::pushToPersistent() {
     if ( _subEventWeights.empty() ) return;
+    Profiler& prof = Profiler::global();
+    const double t0 = prof.enabled() ? Profiler::clock() : 0.0;
+    if ( prof.enabled() ) {
+      for (const auto& apair : _analyses) {
+        size_t nfills = 0;
+        for (const MultiweightAOPtr& ao : apair.second->analysisObjects())
+          nfills += ao.get()->numFills();
+        prof.analysisFills(apair.second->name(), nfills);
+      }
+    }
     MSG_TRACE("AnalysisHandler::analyze(): Pushing _eventCounter to persistent.");
     _eventCounter.get()->pushToPersistent(_subEventWeights);
-    for (const AnaHandle& a : analyses()) {
-      for (auto ao : a->analysisObjects()) {
-        MSG_TRACE("AnalysisHandler::analyze(): Pushing " << a->name()
-                  << "'s " << ao->name() << " to persistent.");
-        ao.get()->pushToPersistent(_subEventWeights);
-      }
-      MSG_TRACE("AnalysisHandler::analyze(): finished pushing "
-                << a->name() << "'s objects to persistent.");
+    for (const MultiweightAOPtr& ao : _rivetAOs) {
+      MSG_TRACE("AnalysisHandler::analyze(): Pushing " << ao->name() << " to persistent.");
+      ao.get()->pushToPersistent(_subEventWeights);
     }
     _subEventWeights.clear();
+    if ( prof.enabled() ) prof.pushCall(t0);
   }
 
   void AnalysisHandler::finalize() {
@@ -260,6 +306,13 @@ namespace Rivet {
     MSG_TRACE("AnalysisHandler::finalize(): Pushing analysis objects to persistent.");
     pushToPersistent();
 
+    // Bring the cross-section up to date with the final weight sums
+    _syncCrossSection();
+
+    // Replay events journaled for self-calibrated centrality binning
+    if ( !_dumping )
+      for (AnaHandle a : analyses()) a->_replayJournals();
+
     // Copy all histos to finalize versions.
     _eventCounter.get()->pushToFinal();
     _xs.get()->pushToFinal();
@@ -296,6 +349,14 @@ namespace Rivet {
 
     _stage = Stage::OTHER;
 
+    // Analyses may book further objects in finalize
+    _collectAOs();
+
+    if ( Profiler::global().enabled() ) {
+      MSG_DEBUG("Writing profiling reports to " << _profileFile << ".{txt,json}");
+      Profiler::global().writeReports(_profileFile);
+    }
+
   }
 
 
@@ -566,6 +627,7 @@ namespace Rivet {
   }
 
   vector<MultiweightAOPtr> AnalysisHandler::getRivetAOs() const {
+      _syncCrossSection();
       vector<MultiweightAOPtr> rtn;
 
       for (AnaHandle a : analyses()) {
@@ -621,6 +683,146 @@ namespace Rivet {
   }
 
 
+  namespace {
+
+    // Identifies a checkpoint file and the version of its layout.
+    const char CHECKPOINT_MAGIC[8] = {'R', 'I', 'V', 'E', 'T', 'C', 'K', 'P'};
+    const uint32_t CHECKPOINT_VERSION = 1;
+
+    template <typename T>
+    void _write(std::ostream& os, const T& x) {
+      os.write(reinterpret_cast<const char*>(&x), sizeof(T));
+    }
+
+    void _writeString(std::ostream& os, const string& s) {
+      _write(os, uint64_t(s.size()));
+      os.write(s.data(), s.size());
+    }
+
+    template <typename T>
+    T _read(std::istream& is) {
+      T x;
+      if ( !is.read(reinterpret_cast<char*>(&x), sizeof(T)) )
+        throw UserError("Truncated checkpoint file");
+      return x;
+    }
+
+    string _readString(std::istream& is) {
+      string s(_read<uint64_t>(is), '\0');
+      if ( !s.empty() && !is.read(&s[0], s.size()) )
+        throw UserError("Truncated checkpoint file");
+      return s;
+    }
+
+  }
+
+
+  void AnalysisHandler::writeCheckpoint(const string& filename, size_t inputoffset) {
+    if ( !_initialised )
+      throw UserError("Cannot write a checkpoint before the run is initialised");
+    pushToPersistent();
+    _syncCrossSection();
+    if ( !_checkpointWarned ) {
+      for ( AnaHandle a : analyses() ) {
+        const string what = _uncheckpointed(a);
+        if ( !what.empty() )
+          MSG_WARNING("Analysis '" << a->name() << "' keeps " << what << " outside its "
+                      << "analysis objects: the run cannot be resumed from " << filename);
+      }
+      _checkpointWarned = true;
+    }
+
+    // The raw analysis objects, including the event counter
+    vector<YODA::AnalysisObjectPtr> raws;
+    for ( auto rao : getRivetAOs() ) {
+      for ( size_t iW = 0; iW < numWeights(); ++iW ) {
+        rao.get()->setActiveWeightIdx(iW);
+        raws.push_back(rao.get()->activeYODAPtr());
+      }
+      rao.get()->unsetActiveWeight();
+    }
+    // Written at full precision, since the resumed run adds to the sums
+    std::ostringstream yoda;
+    YODA::Writer& writer = YODA::mkWriter("yoda");
+    writer.setPrecision(17);
+    writer.write(yoda, raws.begin(), raws.end());
+
+    const string tmpname = filename + ".tmp";
+    {
+      std::ofstream os(tmpname, std::ios::binary | std::ios::trunc);
+      os.write(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+      _write(os, CHECKPOINT_VERSION);
+      _write(os, uint64_t(inputoffset));
+      _write(os, uint32_t(_weightNames.size()));
+      for ( const string& wname : _weightNames ) _writeString(os, wname);
+      _write(os, uint8_t(_xs.get() ? 1 : 0));
+      _write(os, _xsec.first);
+      _write(os, _xsec.second);
+      _writeString(os, yoda.str());
+      _write(os, uint32_t(_analyses.size()));
+      for ( AnaHandle a : analyses() ) {
+        _writeString(os, a->name());
+        _write(os, uint32_t(a->_journals.size()));
+        for ( auto j : a->_journals ) _writeString(os, j->spill());
+      }
+      if ( !os.flush() )
+        throw UserError("Could not write checkpoint file: " + tmpname);
+    }
+    if ( std::rename(tmpname.c_str(), filename.c_str()) != 0 )
+      throw UserError("Could not replace checkpoint file: " + filename);
+    MSG_DEBUG("Wrote checkpoint after " << inputoffset << " input events to " << filename);
+  }
+
+
+  size_t AnalysisHandler::readCheckpoint(const string& filename) {
+    if ( _initialised )
+      throw UserError("A checkpoint must be read before the run is initialised");
+    std::ifstream is(filename, std::ios::binary);
+    if ( !is ) throw UserError("Could not open checkpoint file: " + filename);
+    char magic[sizeof(CHECKPOINT_MAGIC)];
+    if ( !is.read(magic, sizeof(magic)) ||
+         !std::equal(magic, magic + sizeof(magic), CHECKPOINT_MAGIC) )
+      throw UserError("Not a Rivet checkpoint file: " + filename);
+    if ( _read<uint32_t>(is) != CHECKPOINT_VERSION )
+      throw UserError("Unsupported checkpoint file version in " + filename);
+
+    const size_t inputoffset = _read<uint64_t>(is);
+    _resumeWeightNames.resize(_read<uint32_t>(is));
+    for ( string& wname : _resumeWeightNames ) wname = _readString(is);
+    const bool hasxs = _read<uint8_t>(is);
+    _xsec.first = _read<double>(is);
+    _xsec.second = _read<double>(is);
+    _xsecDirty = hasxs;
+
+    std::istringstream yoda(_readString(is));
+    vector<YODA::AnalysisObject*> aos_raw;
+    try {
+      YODA::read(yoda, aos_raw, "yoda");
+    } catch (...) { //< YODA::ReadError&
+      throw UserError("Unexpected error in reading checkpoint file: " + filename);
+    }
+    for (YODA::AnalysisObject* aor : aos_raw)
+      _preloads[aor->path()] = YODA::AnalysisObjectPtr(aor);
+
+    for ( size_t ia = 0, na = _read<uint32_t>(is); ia < na; ++ia ) {
+      vector<string>& spills = _journalPreloads[_readString(is)];
+      spills.resize(_read<uint32_t>(is));
+      for ( string& spill : spills ) spill = _readString(is);
+    }
+
+    MSG_INFO("Resuming from checkpoint " << filename << " after "
+             << inputoffset << " input events");
+    return inputoffset;
+  }
+
+
+  string AnalysisHandler::getJournalPreload(const string& ananame, size_t i) const {
+    auto it = _journalPreloads.find(ananame);
+    if ( it == _journalPreloads.end() || i >= it->second.size() ) return "";
+    return it->second[i];
+  }
+
+
   string AnalysisHandler::runName() const { return _runname; }
   size_t AnalysisHandler::numEvents() const { return _eventCounter->numEntries(); }
 
@@ -652,6 +854,16 @@ namespace Rivet {
 
 
   void AnalysisHandler::setCrossSection(pair<double,double> xsec) {
+    _xsec = xsec;
+    _xsecDirty = true;
+    _syncCrossSection();
+  }
+
+
+  void AnalysisHandler::_syncCrossSection() const {
+    if ( !_xsecDirty ) return;
+    _xsecDirty = false;
+    const pair<double,double>& xsec = _xsec;
     _xs = Scatter1DPtr(weightNames(), Scatter1D("_XSEC"));
     _eventCounter.get()->setActiveWeightIdx(_defaultWeightIdx);
     double nomwgt = sumW();
@@ -668,7 +880,22 @@ namespace Rivet {
 
     _eventCounter.get()->unsetActiveWeight();
     _xs.get()->unsetActiveWeight();
-    return;
+  }
+
+
+  string AnalysisHandler::_uncheckpointed(AnaHandle a) const {
+    if ( !a->uncheckpointed().empty() ) return a->uncheckpointed();
+    for ( ConstProjectionPtr p : a->getProjections() )
+      if ( dynamic_cast<const EventMixingBase*>(p.get()) ) return "event mixing pools";
+    return "";
+  }
+
+
+  void AnalysisHandler::_collectAOs() {
+    _rivetAOs.clear();
+    for (const auto& apair : _analyses)
+      for (const MultiweightAOPtr& ao : apair.second->analysisObjects())
+        _rivetAOs.push_back(ao);
   }
 
   AnalysisHandler& AnalysisHandler::addAnalysis(Analysis* analysis) {
@@ -19,6 +19,13 @@ namespace Rivet {
     Log& getLog() {
       return Log::getLog("Rivet.AnalysisInfo");
     }
+
+    /// Already-parsed info files, keyed by path: plugin registration and
+    /// getAnalysis() would otherwise re-read the same YAML file repeatedly
+    map<string, AnalysisInfo>& infoCache() {
+      static map<string, AnalysisInfo> cache;
+      return cache;
+    }
   }
 
 
@@ -36,6 +43,14 @@ namespace Rivet {
       return ai;
     }
 
+    // Re-use a previous parse of this file if possible
+    const auto ic = infoCache().find(datapath);
+    if (ic != infoCache().end()) {
+      MSG_TRACE("Using cached analysis data from " << datapath);
+      ai.reset( new AnalysisInfo(ic->second) );
+      return ai;
+    }
+
     // Read data from YAML document
     MSG_DEBUG("Reading analysis data from " << datapath);
     YAML::Node doc;
@@ -147,6 +162,7 @@ namespace Rivet {
 
     #undef THROW_INFOERR
 
+    infoCache()[datapath] = *ai;
 
     MSG_TRACE("AnalysisInfo pointer = " << ai.get());
     return ai;
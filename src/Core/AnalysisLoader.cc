@@ -5,6 +5,8 @@
 #include "Rivet/Tools/osdir.hh"
 #include "Rivet/Analysis.hh"
 #include <dlfcn.h>
+#include <sys/stat.h>
+#include <fstream>
 
 namespace Rivet {
 
@@ -18,11 +20,21 @@ namespace Rivet {
   // Initialise static ptr collection
   AnalysisLoader::AnalysisBuilderMap AnalysisLoader::_ptrs;
 
+  // Initialise static plugin-library bookkeeping
+  vector<string> AnalysisLoader::_pluginfiles;
+  set<string> AnalysisLoader::_loadedfiles;
+  map<string, string> AnalysisLoader::_pluginindex;
+  bool AnalysisLoader::_fullyIndexed = false;
+
 
   vector<string> AnalysisLoader::analysisNames() {
-    _loadAnalysisPlugins();
-    vector<string> names;
-    for (const AnalysisBuilderMap::value_type& p : _ptrs) names += p.first;
+    // If every plugin lib is indexed, the names can be listed without opening any of them
+    _findAnalysisPlugins();
+    if (!_fullyIndexed) _loadAnalysisPlugins();
+    set<string> nameset;
+    for (const AnalysisBuilderMap::value_type& p : _ptrs) nameset.insert(p.first);
+    for (const auto& p : _pluginindex) nameset.insert(p.first);
+    vector<string> names(nameset.begin(), nameset.end());
     return names;
   }
 
@@ -38,8 +50,13 @@ namespace Rivet {
 
 
   unique_ptr<Analysis> AnalysisLoader::getAnalysis(const string& analysisname) {
-    _loadAnalysisPlugins();
+    // Try already-registered builders, then the indexed lib, then fall back to loading everything
     AnalysisBuilderMap::const_iterator ai = _ptrs.find(analysisname);
+    if (ai == _ptrs.end() && _loadIndexedPlugin(analysisname)) ai = _ptrs.find(analysisname);
+    if (ai == _ptrs.end()) {
+      _loadAnalysisPlugins();
+      ai = _ptrs.find(analysisname);
+    }
     if (ai == _ptrs.end()) return nullptr;
     return ai->second->mkAnalysis();
   }
@@ -80,16 +97,17 @@ namespace Rivet {
   }
 
 
-  void AnalysisLoader::_loadAnalysisPlugins() {
+  void AnalysisLoader::_findAnalysisPlugins() {
     // Only run once
-    if (!_ptrs.empty()) return;
+    static bool found = false;
+    if (found) return;
+    found = true;
 
     // Build the list of directories to search
     const vector<string> dirs = getAnalysisLibPaths();
 
     // Find plugin module library files
     const string libsuffix = ".so";
-    vector<string> pluginfiles;
     for (const string& d : dirs) {
       if (d.empty()) continue;
       oslink::directory dir(d);
@@ -103,22 +121,65 @@ namespace Rivet {
         /// @todo Sys-dependent path separator instead of "/"
         const string path = d + "/" + filename;
         // Ensure no duplicate paths
-        if (find(pluginfiles.begin(), pluginfiles.end(), path) == pluginfiles.end()) {
-          pluginfiles += path;
+        if (find(_pluginfiles.begin(), _pluginfiles.end(), path) == _pluginfiles.end()) {
+          _pluginfiles += path;
         }
       }
     }
-
-    // Load the plugin files
-    MSG_TRACE("Candidate analysis plugin libs: " << pluginfiles);
-    for (const string& pf : pluginfiles) {
-      MSG_TRACE("Trying to load plugin analyses from file " << pf);
-      void* handle = dlopen(pf.c_str(), RTLD_LAZY);
-      if (!handle) {
-        MSG_WARNING("Cannot open " << pf << ": " << dlerror());
+    MSG_TRACE("Candidate analysis plugin libs: " << _pluginfiles);
+
+    // Read the analysis-name indices written alongside each lib by rivet-buildplugin.
+    // An index older than its lib is ignored, and such libs get opened on any lookup miss.
+    _fullyIndexed = true;
+    for (const string& pf : _pluginfiles) {
+      const string idxpath = pf.substr(0, pf.length()-libsuffix.length()) + ".idx";
+      struct stat libstat, idxstat;
+      if (stat(pf.c_str(), &libstat) != 0 || stat(idxpath.c_str(), &idxstat) != 0 ||
+          idxstat.st_mtime < libstat.st_mtime) {
+        MSG_TRACE("No up-to-date analysis index for plugin lib " << pf);
+        _fullyIndexed = false;
         continue;
       }
+      std::ifstream idxfile(idxpath.c_str());
+      string ananame;
+      while (idxfile >> ananame) {
+        // Earlier paths take precedence, as for duplicate registrations
+        if (_pluginindex.find(ananame) == _pluginindex.end()) _pluginindex[ananame] = pf;
+      }
+    }
+  }
+
+
+  bool AnalysisLoader::_loadPluginLib(const string& path) {
+    if (_loadedfiles.find(path) != _loadedfiles.end()) return true;
+    _loadedfiles.insert(path);
+    MSG_TRACE("Trying to load plugin analyses from file " << path);
+    void* handle = dlopen(path.c_str(), RTLD_LAZY);
+    if (!handle) {
+      MSG_WARNING("Cannot open " << path << ": " << dlerror());
+      return false;
     }
+    return true;
+  }
+
+
+  bool AnalysisLoader::_loadIndexedPlugin(const string& analysisname) {
+    _findAnalysisPlugins();
+    const auto ip = _pluginindex.find(analysisname);
+    if (ip == _pluginindex.end()) return false;
+    return _loadPluginLib(ip->second);
+  }
+
+
+  void AnalysisLoader::_loadAnalysisPlugins() {
+    // Only run once
+    static bool loaded = false;
+    if (loaded) return;
+    loaded = true;
+
+    // Load all the plugin files not already opened via the index
+    _findAnalysisPlugins();
+    for (const string& pf : _pluginfiles) _loadPluginLib(pf);
   }
 
 
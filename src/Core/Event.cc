@@ -21,7 +21,7 @@ namespace Rivet {
     // If RIVET_WEIGHT_INDEX=-1, or there are no event weights, return 1
     if (WEIGHT_INDEX == -1 || genEvent()->weights().empty()) return 1.0;
     // Otherwise return the appropriate weight index
-    return _genevent.weights()[WEIGHT_INDEX];
+    return _genevent->weights()[WEIGHT_INDEX];
   }
   */
 
@@ -32,11 +32,22 @@ namespace Rivet {
   double Event::asqrtS() const { return Rivet::asqrtS(beams()); }
 
 
-  void Event::_init(const GenEvent& ge) {
+  void Event::_init(const GenEvent& ge, bool strip) {
     // Use Rivet's preferred units if possible
+    bool convert = false;
     #ifdef HEPMC_HAS_UNITS
-    _genevent.use_units(HepMC::Units::GEV, HepMC::Units::MM);
+    convert = ge.momentum_unit() != HepMC::Units::GEV || ge.length_unit() != HepMC::Units::MM;
     #endif
+
+    // Wrap the original event directly if it doesn't need to be touched
+    if (!strip && !convert) return;
+
+    _genevent_copy = std::make_shared<GenEvent>(ge);
+    #ifdef HEPMC_HAS_UNITS
+    if (convert) _genevent_copy->use_units(HepMC::Units::GEV, HepMC::Units::MM);
+    #endif
+    if (strip) _strip(*_genevent_copy);
+    _genevent = _genevent_copy.get();
   }
 
   void Event::_strip(GenEvent & ge) {
@@ -54,7 +65,7 @@ namespace Rivet {
 
 
   std::valarray<double> Event::weights() const {
-    return HepMCUtils::weights(_genevent);
+    return HepMCUtils::weights(*_genevent);
   }
   
 }
@@ -9,8 +9,10 @@ namespace Rivet {
 
   Jet& Jet::clear() {
     _momentum = FourMomentum();
+    _invalidateKinematics();
     _pseudojet.reset(0,0,0,0);
     _particles.clear();
+    _tagbits = TAGBITS_UNSET;
     return *this;
   }
 
@@ -18,6 +20,7 @@ namespace Rivet {
   Jet& Jet::setState(const FourMomentum& mom, const Particles& particles, const Particles& tags) {
     clear();
     _momentum = mom;
+    _invalidateKinematics();
     _pseudojet = fastjet::PseudoJet(mom.px(), mom.py(), mom.pz(), mom.E());
     _particles = particles;
     _tags = tags;
@@ -29,6 +32,7 @@ namespace Rivet {
     clear();
     _pseudojet = pj;
     _momentum = FourMomentum(pj.e(), pj.px(), pj.py(), pj.pz());
+    _invalidateKinematics();
     _particles = particles;
     _tags = tags;
     // if (_particles.empty()) {
@@ -54,6 +58,7 @@ namespace Rivet {
 
   Jet& Jet::setParticles(const Particles& particles) {
     _particles = particles;
+    _tagbits = TAGBITS_UNSET;
     return *this;
   }
 
@@ -90,6 +95,7 @@ namespace Rivet {
 
   Jet& Jet::transformBy(const LorentzTransform& lt) {
     _momentum = lt.transform(_momentum);
+    _invalidateKinematics();
     for (Particle& p : _particles) p.transformBy(lt);
     for (Particle& t : _tags) t.transformBy(lt);
     _pseudojet.reset(_momentum.px(), _momentum.py(), _momentum.pz(), _momentum.E()); //< lose ClusterSeq etc.
@@ -164,6 +170,46 @@ namespace Rivet {
     return filter_select(tags(), c);
   }
 
+
+  unsigned int Jet::tagBits() const {
+    if (_tagbits != TAGBITS_UNSET) return _tagbits;
+    unsigned int bits = 0;
+    for (const Particle& tp : tags()) {
+      if (hasBottom(tp)) bits |= BTAG;
+      else if (hasCharm(tp)) bits |= CTAG;
+      if (isTau(tp)) bits |= TAUTAG;
+    }
+    // Fall back to b and c quark constituents, as in bTags() and cTags()
+    if (!(bits & BTAG) && any(constituents(), hasAbsPID(PID::BQUARK))) bits |= BTAG;
+    if (!(bits & CTAG) && any(constituents(), hasAbsPID(PID::CQUARK))) bits |= CTAG;
+    _tagbits = bits;
+    return bits;
+  }
+
+
+  bool Jet::hadronicTauTagged() const {
+    if (!(tagBits() & TAUTAG)) return false;
+    for (const Particle& tp : tauTags())
+      if (any(tp.stableDescendants(), isHadron)) return true;
+    return false;
+  }
+
+
+  bool Jet::bTagged(const Cut& c) const {
+    if (c == Cuts::open()) return tagBits() & BTAG;
+    return !bTags(c).empty();
+  }
+
+  bool Jet::cTagged(const Cut& c) const {
+    if (c == Cuts::open()) return tagBits() & CTAG;
+    return !cTags(c).empty();
+  }
+
+  bool Jet::tauTagged(const Cut& c) const {
+    if (c == Cuts::open()) return tagBits() & TAUTAG;
+    return !tauTags(c).empty();
+  }
+
   Particles Jet::bTags(const Cut& c) const {
     Particles rtn;
     // First try for ghost-associated b-tag particles
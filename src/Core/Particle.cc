@@ -8,21 +8,29 @@ namespace Rivet {
 
   void Particle::setConstituents(const Particles& cs, bool setmom) {
     _constituents = cs;
-    if (setmom) _momentum = sum(cs, p4, FourMomentum());
+    if (setmom) {
+      _momentum = sum(cs, p4, FourMomentum());
+      _invalidateKinematics();
+    }
   }
 
 
   void Particle::addConstituent(const Particle& c, bool addmom) {
     _constituents += c;
-    if (addmom) _momentum += c;
+    if (addmom) {
+      _momentum += c;
+      _invalidateKinematics();
+    }
   }
 
 
   void Particle::addConstituents(const Particles& cs, bool addmom) {
     _constituents += cs;
-    if (addmom)
+    if (addmom) {
       for (const Particle& c : cs)
         _momentum += c;
+      _invalidateKinematics();
+    }
   }
 
 
@@ -36,6 +44,7 @@ namespace Rivet {
 
   Particle& Particle::transformBy(const LorentzTransform& lt) {
     _momentum = lt.transform(_momentum);
+    _invalidateKinematics();
     return *this;
   }
 
@@ -120,7 +129,7 @@ namespace Rivet {
   /// @todo Use recursion through replica-avoiding functions to avoid bookkeeping duplicates
   Particles Particle::allDescendants(const Cut& c, bool remove_duplicates) const {
     Particles rtn;
-    if (isStable()) return rtn;
+    if (isStable() || genParticle() == nullptr) return rtn;
 
     ConstGenVertexPtr gv = genParticle()->end_vertex();
     if (gv == nullptr) return rtn;
@@ -148,7 +157,7 @@ namespace Rivet {
   /// @todo Insist that the current particle is post-hadronization, otherwise throw an exception?
   Particles Particle::stableDescendants(const Cut& c) const {
     Particles rtn;
-    if (isStable()) return rtn;
+    if (isStable() || genParticle() == nullptr) return rtn;
     ConstGenVertexPtr gv = genParticle()->end_vertex();
     if (gv == nullptr) return rtn;
     /// @todo Would like to do this, but the range objects are broken
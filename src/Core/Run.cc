@@ -5,6 +5,7 @@
 #include "Rivet/Tools/RivetPaths.hh"
 #include <limits>
 #include <iostream>
+#include <unistd.h>
 
 using std::cout;
 using std::endl;
@@ -12,7 +13,7 @@ using std::endl;
 namespace Rivet {
 
   Run::Run(AnalysisHandler& ah)
-    : _ah(ah), _fileweight(1.0), _xs(NAN)
+    : _ah(ah), _fileweight(1.0), _xs(NAN), _evtok(false), _evtfailed(false)
   { }
 
 
@@ -35,7 +36,8 @@ namespace Rivet {
   bool Run::readEvent() {
     /// @todo Clear rather than new the GenEvent object per-event?
     _evt.reset(new GenEvent());
-    if (!HepMCUtils::readEvent(_hepmcReader, _evt)){
+    _evtok = HepMCUtils::readEvent(_hepmcReader, _evt);
+    if (!_evtok) {
       Log::getLog("Rivet.Run") << Log::DEBUG << "Read failed. End of file?" << endl;
       return false;
     }
@@ -113,6 +115,34 @@ namespace Rivet {
   }
 
 
+  size_t Run::skipEvents(size_t n) {
+    size_t nskipped = 0;
+    while (nskipped < n && _evtok) {
+      readEvent();
+      ++nskipped;
+    }
+    return nskipped;
+  }
+
+
+  size_t Run::processEvents(size_t n, unsigned int evttimeout) {
+    size_t nprocessed = 0;
+    _evtfailed = false;
+    while (nprocessed < n && _evtok) {
+      if (!processEvent()) {
+        _evtfailed = true;
+        break;
+      }
+      ++nprocessed;
+      // Read the next event, interrupted by SIGALRM if it takes too long
+      if (evttimeout > 0) alarm(evttimeout);
+      readEvent();
+      if (evttimeout > 0) alarm(0);
+    }
+    return nprocessed;
+  }
+
+
   bool Run::finalize() {
     _evt.reset();
 
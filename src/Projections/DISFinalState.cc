@@ -30,10 +30,9 @@ namespace Rivet {
     // const GenParticlePtr dislepIN = dislep.in().genParticle();
 
     for (const Particle& p : fs.particles()) { ///< Ensure that we skip the DIS lepton
-      Particle temp = p;
-      if (_boosttype != BoostFrame::LAB) temp.setMomentum(hcmboost.transform(temp.momentum()));
-      if (p.genParticle() != dislepGP)  _theParticles.push_back(temp);
+      if (p.genParticle() != dislepGP)  _theParticles.push_back(p);
     }
+    if (_boosttype != BoostFrame::LAB) transformBy(_theParticles, hcmboost);
   }
 
 
@@ -0,0 +1,66 @@
+// -*- C++ -*-
+#include "Rivet/Projections/DecayGraph.hh"
+
+namespace Rivet {
+
+
+  bool DecayGraph::lastCopy(ConstGenParticlePtr gp) {
+    ConstGenVertexPtr dv = gp->end_vertex();
+    if (dv == nullptr) return true;
+    for (ConstGenParticlePtr c : HepMCUtils::particles(dv, Relatives::CHILDREN)) {
+      if (c->pdg_id() == gp->pdg_id() && c->status() == 2) return false;
+    }
+    return true;
+  }
+
+
+  bool DecayGraph::bottomChild(ConstGenParticlePtr gp) {
+    ConstGenVertexPtr dv = gp->end_vertex();
+    if (dv == nullptr) return false;
+    for (ConstGenParticlePtr c : HepMCUtils::particles(dv, Relatives::CHILDREN)) {
+      if (PID::hasBottom(c->pdg_id())) return true;
+    }
+    return false;
+  }
+
+
+  bool DecayGraph::charmChild(ConstGenParticlePtr gp) {
+    ConstGenVertexPtr dv = gp->end_vertex();
+    if (dv == nullptr) return false;
+    for (ConstGenParticlePtr c : HepMCUtils::particles(dv, Relatives::CHILDREN)) {
+      if (PID::hasCharm(c->pdg_id())) return true;
+    }
+    return false;
+  }
+
+
+  void DecayGraph::project(const Event&) {
+    // Nothing is walked up front: just forget the previous event's depths
+    _depths.clear();
+  }
+
+
+  unsigned int DecayGraph::_vertexDepth(ConstGenVertexPtr vtx) const {
+    if (vtx == nullptr) return 0;
+
+    // Vertex IDs are negative and dense in both HepMC versions; anything else isn't memoised
+    const int id = HepMCUtils::uniqueId(vtx);
+    const size_t slot = id < 0 ? size_t(-id) : 0;
+    if (slot > 0) {
+      if (slot >= _depths.size()) _depths.resize(slot+1, -1);
+      if (_depths[slot] >= 0) return _depths[slot];
+      _depths[slot] = 0; //< guard against loops in malformed event graphs
+    }
+
+    unsigned int rtn = 0;
+    for (ConstGenParticlePtr pa : HepMCUtils::particles(vtx, Relatives::PARENTS)) {
+      /// @todo Are hadrons from tau decays "primary hadrons"? I guess not
+      const bool decayed = pa->status() == 2 && (PID::isHadron(pa->pdg_id()) || abs(pa->pdg_id()) == PID::TAU);
+      rtn = max(rtn, _vertexDepth(pa->production_vertex()) + (decayed ? 1 : 0));
+    }
+    if (slot > 0) _depths[slot] = rtn;
+    return rtn;
+  }
+
+
+}
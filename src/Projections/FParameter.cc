@@ -7,6 +7,8 @@ namespace Rivet {
   FParameter::FParameter(const FinalState& fsp) {
     setName("FParameter");
     declare(fsp, "FS");
+    // The transverse tensor is accumulated along with the sphericity tensors
+    declare(Sphericity(fsp), "Sphericity");
     clear();
   }
 
@@ -17,8 +19,8 @@ namespace Rivet {
 
 
   void FParameter::project(const Event& e) {
-    const Particles prts = applyProjection<FinalState>(e, "FS").particles();
-    calc(prts);
+    const Sphericity& sph = applyProjection<Sphericity>(e, "Sphericity");
+    _calcFParameter(sph.momentumTensors().trans);
   }
 
 
@@ -27,74 +29,43 @@ namespace Rivet {
   }
 
   void FParameter::calc(const vector<Particle>& fsparticles) {
-    vector<Vector3> threeMomenta;
-    threeMomenta.reserve(fsparticles.size());
-    for (const Particle& p : fsparticles) {
-      const Vector3 p3 = p.momentum().vector3();
-      threeMomenta.push_back(p3);
-    }
-    _calcFParameter(threeMomenta);
+    PackedMomenta momenta;
+    momenta.add(fsparticles);
+    _calcFParameter(momenta);
   }
 
   void FParameter::calc(const vector<FourMomentum>& fsmomenta) {
-    vector<Vector3> threeMomenta;
-    threeMomenta.reserve(fsmomenta.size());
-    for (const FourMomentum& v : fsmomenta) {
-      threeMomenta.push_back(v.vector3());
-    }
-    _calcFParameter(threeMomenta);
+    PackedMomenta momenta;
+    momenta.add(fsmomenta);
+    _calcFParameter(momenta);
   }
 
   void FParameter::calc(const vector<Vector3>& fsmomenta) {
-    _calcFParameter(fsmomenta);
+    PackedMomenta momenta;
+    momenta.reserve(fsmomenta.size());
+    for (const Vector3& p3 : fsmomenta) momenta.push_back(p3);
+    _calcFParameter(momenta);
   }
 
-  // Actually do the calculation
-  void FParameter::_calcFParameter(const vector<Vector3>& fsmomenta) {
-
+  void FParameter::_calcFParameter(const PackedMomenta& fsmomenta) {
     // Return (with "safe nonsense" sphericity params) if there are no final state particles.
     if (fsmomenta.empty()) {
       MSG_DEBUG("No particles in final state...");
       clear();
       return;
     }
+    MSG_DEBUG("Number of particles = " << fsmomenta.size());
+    _calcFParameter(fsmomenta.tensors().trans);
+  }
 
-    // A small iteration over full momenta but set z-coord. to 0.0 to get transverse momenta
-    vector <Vector3> fsperpmomenta;
-    for (const Vector3& p : fsmomenta) {
-      fsperpmomenta.push_back(Vector3(p.x(), p.y(), 0.0));
-    }
-
-    // Iterate over all the final state particles.
-    Matrix<2> mMom;
-    MSG_DEBUG("Number of particles = " << fsperpmomenta.size());
-    for (const Vector3& p3 : fsperpmomenta) {
-
-      double prefactor = 1.0/p3.mod();
-
-      Matrix<2> mMomPart;
-      for (size_t i = 0; i < 2; ++i) {
-        for (size_t j = 0; j < 2; ++j) {
-          mMomPart.set(i,j, p3[i]*p3[j]);
-        }
-      }
-      mMom += prefactor * mMomPart;
-    }
-
-    MSG_DEBUG("Linearised transverse momentum tensor = " << mMom);
-
-    // Check that the matrix is symmetric.
-    const bool isSymm = mMom.isSymm();
-    if (!isSymm) {
-      MSG_ERROR("Error: momentum tensor not symmetric:");
-      MSG_ERROR("[0,1] vs. [1,0]: " << mMom.get(0,1) << ", " << mMom.get(1,0));
-    }
-    // If not symmetric, something's wrong (we made sure the error msg appeared first).
+  // Actually do the calculation
+  void FParameter::_calcFParameter(const std::array<double,3>& mMom) {
+    MSG_DEBUG("Linearised transverse momentum tensor (xx, yy, xy) = ("
+              << mMom[0] << ", " << mMom[1] << ", " << mMom[2] << ")");
 
-    assert(isSymm);
-    const double a = mMom.get(0,0);
-    const double b = mMom.get(1,1);
-    const double c = mMom.get(1,0);
+    const double a = mMom[0];
+    const double b = mMom[1];
+    const double c = mMom[2];
 
     const double l1 = 0.5*(a+b+sqrt( (a-b)*(a-b) + 4 *c*c));
     const double l2 = 0.5*(a+b-sqrt( (a-b)*(a-b) + 4 *c*c));
@@ -173,6 +173,8 @@ namespace Rivet {
     MSG_DEBUG("Finding jets from " << fsparticles.size() << " input particles + " << tagparticles.size() << " tagging particles");
     _fsparticles = fsparticles;
     _tagparticles = tagparticles;
+    _jetcache.clear();
+    _jetcacheValid = false;
 
     // Make pseudojets, with mapping info to Rivet FS and tag particles
     PseudoJets pjs = mkClusterInputs(_fsparticles, _tagparticles);
@@ -194,13 +196,18 @@ namespace Rivet {
     _yscales.clear();
     _fsparticles.clear();
     _tagparticles.clear();
+    _jetcache.clear();
+    _jetcacheValid = false;
     /// @todo _cseq = fastjet::ClusterSequence();
   }
 
 
   Jets FastJets::_jets() const {
-    /// @todo Cache?
-    return mkJets(pseudojets(), _fsparticles, _tagparticles);
+    if (!_jetcacheValid) {
+      _jetcache = mkJets(pseudojets(), _fsparticles, _tagparticles);
+      _jetcacheValid = true;
+    }
+    return _jetcache;
   }
 
 
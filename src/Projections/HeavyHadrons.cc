@@ -27,30 +27,13 @@ namespace Rivet {
       }
       // There are descendants -- check them for b or c content
       /// @todo What about charm hadrons coming from bottom hadron decays?
-      vector<ConstGenParticlePtr> children = HepMCUtils::particles(p.genParticle(), Relatives::CHILDREN);
       if (hasBottom(p)) {
-        bool has_b_child = false;
-        
-        for (ConstGenParticlePtr p2 : children) {
-          if (PID::hasBottom(p2->pdg_id())) {
-            has_b_child = true;
-            break;
-          }
-        }
-        if (!has_b_child) {
+        if (!DecayGraph::bottomChild(p.genParticle())) {
           _theParticles.push_back(p);
           _theBs.push_back(p);
         }
       } else if (hasCharm(p)) {
-        bool has_c_child = false;
-
-        for (ConstGenParticlePtr p2 : children) {
-          if (PID::hasCharm(p2->pdg_id())) {
-            has_c_child = true;
-            break;
-          }
-        }
-        if (!has_c_child) {
+        if (!DecayGraph::charmChild(p.genParticle())) {
           _theParticles.push_back(p);
           _theCs.push_back(p);
         }
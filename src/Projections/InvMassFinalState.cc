@@ -83,79 +83,150 @@ namespace Rivet {
   }
 
 
+  namespace {
+
+    /// @brief Pair candidates of one type, with their kinematics packed into flat arrays
+    ///
+    /// The scale is an upper bound contribution to the pair mass: the energy
+    /// for the invariant mass, and the pT for the transverse mass.
+    struct PairCandidates {
+      vector<size_t> index, pidclass;
+      vector<double> E, px, py, pz, scale;
+
+      void add(size_t i, size_t cls, const FourMomentum& p, bool transverse) {
+        index.push_back(i);
+        pidclass.push_back(cls);
+        E.push_back(p.E());
+        px.push_back(p.px());
+        py.push_back(p.py());
+        pz.push_back(p.pz());
+        scale.push_back(transverse ? p.pT() : p.E());
+      }
+
+      size_t size() const { return index.size(); }
+    };
+
+  }
+
+
   void InvMassFinalState::calc(const Particles& inparticles) {
     _theParticles.clear();
     _particlePairs.clear();
 
-    // Containers for the particles of type specified in the pair
-    vector<const Particle*> type1, type2;
+    // Give each distinct decay-product ID a class index, and tabulate which
+    // (first, second) class combinations are requested pairs
+    vector<PdgId> pids;
+    auto pidclass = [&](PdgId pid) -> size_t {
+      const auto ip = find(pids.begin(), pids.end(), pid);
+      if (ip != pids.end()) return ip - pids.begin();
+      pids.push_back(pid);
+      return pids.size() - 1;
+    };
+    for (const PdgIdPair& ipair : _decayids) {
+      pidclass(ipair.first);
+      pidclass(ipair.second);
+    }
+    const size_t nclasses = pids.size();
+    vector<bool> ispair(nclasses*nclasses, false);
+    for (const PdgIdPair& ipair : _decayids)
+      ispair[pidclass(ipair.first)*nclasses + pidclass(ipair.second)] = true;
+
     // Get all the particles of the type specified in the pair from the particle list
-    for (const Particle& ipart : inparticles) {
-      // Loop around possible particle pairs
+    PairCandidates type1, type2;
+    for (size_t i = 0; i < inparticles.size(); ++i) {
+      const Particle& ipart = inparticles[i];
+      // Loop around possible particle pairs, evaluating the cuts at most once
+      int accepted = -1;
       for (const PdgIdPair& ipair : _decayids) {
-        if (ipart.pid() == ipair.first) {
-          if (accept(ipart)) type1 += &ipart;
-        } else if (ipart.pid() == ipair.second) {
-          if (accept(ipart)) type2 += &ipart;
-        }
+        const bool is1 = ipart.pid() == ipair.first;
+        if (!is1 && ipart.pid() != ipair.second) continue;
+        if (accepted < 0) accepted = accept(ipart) ? 1 : 0;
+        if (!accepted) break;
+        PairCandidates& cands = is1 ? type1 : type2;
+        cands.add(i, pidclass(ipart.pid()), ipart.momentum(), _useTransverseMass);
       }
     }
-    if (type1.empty() || type2.empty()) return;
+    if (type1.size() == 0 || type2.size() == 0) return;
 
-    // Temporary container of selected particles iterators
-    // Useful to compare iterators and avoid double occurrences of the same
-    // particle in case it matches with more than another particle
-    vector<const Particle*> tmp;
+    // Visit the second candidates in decreasing mass-bound scale, so the
+    // loop can stop once no remaining partner can reach the lower mass limit
+    vector<size_t> order2(type2.size());
+    for (size_t j = 0; j < order2.size(); ++j) order2[j] = j;
+    const bool prune = _minmass > 0;
+    if (prune) {
+      std::stable_sort(order2.begin(), order2.end(),
+                       [&](size_t a, size_t b) { return type2.scale[a] > type2.scale[b]; });
+    }
 
-    // Now calculate the inv mass
-    pair<double, pair<Particle, Particle> > closestPair;
-    closestPair.first = 1e30;
-    for (const Particle* i1 : type1) {
-      for (const Particle* i2 : type2) {
+    // Loose squared-mass window, for cheap rejection before the exact test
+    const double minmass2 = (_minmass > 0) ? sqr(_minmass) * (1 - 1e-6) : -DBL_MAX;
+    const double maxmass2 = sqr(_maxmass) * (1 + 1e-6);
+
+    // Find the pairs in the mass window, as (type1, type2) candidate positions
+    vector<pair<size_t, size_t> > selected;
+    for (size_t i1 = 0; i1 < type1.size(); ++i1) {
+      const size_t row = type1.pidclass[i1] * nclasses;
+      for (size_t i2 : order2) {
+        if (prune && type1.scale[i1] + type2.scale[i2] < _minmass) break;
         // Check this is actually a pair
         // (if more than one pair in vector particles can be unrelated)
-        bool found = false;
-        for (const PdgIdPair& ipair : _decayids) {
-          if (i1->pid() == ipair.first && i2->pid() == ipair.second) {
-            found = true;
-            break;
-          }
+        if (!ispair[row + type2.pidclass[i2]]) continue;
+        if (!_useTransverseMass) {
+          const double E = type1.E[i1] + type2.E[i2];
+          const double px = type1.px[i1] + type2.px[i2];
+          const double py = type1.py[i1] + type2.py[i2];
+          const double pz = type1.pz[i1] + type2.pz[i2];
+          const double m2 = E*E - px*px - py*py - pz*pz;
+          if (m2 > 0 && (m2 < minmass2 || m2 > maxmass2)) continue;
         }
-        if (!found) continue;
 
-        FourMomentum v4 = i1->momentum() + i2->momentum();
+        // Exact test on the survivors
+        const FourMomentum& p1 = inparticles[type1.index[i1]].momentum();
+        const FourMomentum& p2 = inparticles[type2.index[i2]].momentum();
+        FourMomentum v4 = p1 + p2;
         if (v4.mass2() < 0) {
           MSG_DEBUG("Constructed negative inv mass2: skipping!");
           continue;
         }
         bool passedMassCut = false;
         if (_useTransverseMass) {
-          passedMassCut = inRange(mT(i1->momentum(), i2->momentum()), _minmass, _maxmass);
+          passedMassCut = inRange(mT(p1, p2), _minmass, _maxmass);
         } else {
           passedMassCut = inRange(v4.mass(), _minmass, _maxmass);
         }
+        if (passedMassCut) selected.push_back(make_pair(i1, i2));
+      }
+    }
+    // Restore the input ordering of the pairs
+    if (prune) std::sort(selected.begin(), selected.end());
 
-        if (passedMassCut) {
-          MSG_DEBUG("Selecting particles with IDs " << i1->pid() << " & " << i2->pid()
-                    << " and mass = " << v4.mass()/GeV << " GeV");
-          // Store accepted particles, avoiding duplicates
-          if (find(tmp.begin(), tmp.end(), i1) == tmp.end()) {
-            tmp.push_back(i1);
-            _theParticles += *i1;
-          }
-          if (find(tmp.begin(), tmp.end(), i2) == tmp.end()) {
-            tmp.push_back(i2);
-            _theParticles += *i2;
-          }
-          // Store accepted particle pairs
-          _particlePairs += make_pair(*i1, *i2);
-          if (_masstarget>0.0) {
-            double diff=fabs(v4.mass()-_masstarget);
-            if (diff<closestPair.first) {
-              closestPair.first=diff;
-              closestPair.second=make_pair(*i1, *i2);
-            }
-          }
+    // Store accepted particles, flagging them to avoid duplicates in case
+    // a particle matches with more than one other particle
+    vector<bool> used(inparticles.size(), false);
+    pair<double, pair<Particle, Particle> > closestPair;
+    closestPair.first = 1e30;
+    for (const pair<size_t, size_t>& ipair : selected) {
+      const size_t i1 = type1.index[ipair.first], i2 = type2.index[ipair.second];
+      const Particle& p1 = inparticles[i1];
+      const Particle& p2 = inparticles[i2];
+      const double mass = (p1.momentum() + p2.momentum()).mass();
+      MSG_DEBUG("Selecting particles with IDs " << p1.pid() << " & " << p2.pid()
+                << " and mass = " << mass/GeV << " GeV");
+      if (!used[i1]) {
+        used[i1] = true;
+        _theParticles += p1;
+      }
+      if (!used[i2]) {
+        used[i2] = true;
+        _theParticles += p2;
+      }
+      // Store accepted particle pairs
+      _particlePairs += make_pair(p1, p2);
+      if (_masstarget > 0.0) {
+        double diff = fabs(mass - _masstarget);
+        if (diff < closestPair.first) {
+          closestPair.first = diff;
+          closestPair.second = make_pair(p1, p2);
         }
       }
     }
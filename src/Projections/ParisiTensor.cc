@@ -21,13 +21,21 @@ namespace Rivet {
   void ParisiTensor::project(const Event & e) {
     clear();
 
-    // Apply sphericity projection to event
-    Sphericity sph = applyProjection<Sphericity>(e, "Sphericity");
+    // Take the linearised tensor from the sphericity projection
+    const Sphericity& sph = applyProjection<Sphericity>(e, "Sphericity");
+    const MomentumTensors& tensors = sph.momentumTensors();
+    SymMatrix3 theta = tensors.lin;
+    // Leave all zero in the same cases as Sphericity does
+    if (theta[2] == 0 && theta[4] == 0 && theta[5] == 0) return;
+    for (double& t : theta) t /= tensors.linNorm;
 
     // Set parameters
-    _lambda[0] = sph.lambda1();
-    _lambda[1] = sph.lambda2();
-    _lambda[2] = sph.lambda3();
+    double l1, l2, l3;
+    symEigenvalues(theta, l1, l2, l3);
+    if (l1 == 0 || l2 == 0 || l3 == 0) return;
+    _lambda[0] = l1;
+    _lambda[1] = l2;
+    _lambda[2] = l3;
     _C = 3 * ( lambda1()*lambda2() + lambda1()*lambda3() + lambda2()*lambda3() );
     _D = 27 * lambda1() * lambda2() * lambda3();
   }
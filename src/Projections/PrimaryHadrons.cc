@@ -8,6 +8,7 @@ namespace Rivet {
     _theParticles.clear();
 
     const Particles& unstables = applyProjection<FinalState>(e, "UFS").particles();
+    const DecayGraph& graph = applyProjection<DecayGraph>(e, "Graph");
     for (const Particle& p : unstables) {
       // Exclude taus etc.
       if (!isHadron(p)) continue;
@@ -17,20 +18,8 @@ namespace Rivet {
         _theParticles.push_back(p);
         continue;
       }
-      // There are ancestors -- check them for status=2 hadronic content
-      vector<ConstGenParticlePtr> ancestors = HepMCUtils::particles(p.genParticle(), Relatives::ANCESTORS);
-      bool has_hadron_parent = false;
-
-      for (ConstGenParticlePtr pa : ancestors) {
-        if (pa->status() != 2) continue;
-        /// @todo Are hadrons from tau decays "primary hadrons"? I guess not
-        if (PID::isHadron(pa->pdg_id()) || abs(pa->pdg_id()) == PID::TAU) {
-          has_hadron_parent = true;
-          break;
-        }
-      }
-      // If the particle seems to be a primary hadron, add it to the list
-      if (!has_hadron_parent) _theParticles.push_back(p);
+      // If the particle has no status=2 hadron (or tau) ancestors, it's a primary hadron
+      if (graph.hadronDepth(p.genParticle()) == 0) _theParticles.push_back(p);
     }
 
     MSG_DEBUG("Number of primary hadrons = " << _theParticles.size());
@@ -28,9 +28,12 @@
 //----------------------------------------------------------------------
 //FJENDHEADER
 
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
+#include <set>
+#include <vector>
 #include "Rivet/Projections/PxConePlugin.hh"
 
 #include "fastjet/ClusterSequence.hh"
@@ -69,7 +72,7 @@ void PxConePlugin::run_clustering(fastjet::ClusterSequence & clust_seq) const {
   int mode = 2;
 
   int    ntrak = clust_seq.jets().size(), itkdm = 4;
-  double *ptrak = new double[ntrak*4+1];
+  vector<double> ptrak(ntrak*4+1);
   for (int i = 0; i < ntrak; i++) {
     ptrak[4*i+0] = clust_seq.jets()[i].px();
     ptrak[4*i+1] = clust_seq.jets()[i].py();
@@ -80,9 +83,9 @@ void PxConePlugin::run_clustering(fastjet::ClusterSequence & clust_seq) const {
   // max number of allowed jets
   int mxjet = ntrak;
   int njet;
-  double *pjet  = new double[mxjet*5+1];
-  int    *ipass = new int[ntrak+1];
-  int    *ijmul = new int[mxjet+1];
+  vector<double> pjet(mxjet*5+1);
+  vector<int>    ipass(ntrak+1);
+  vector<int>    ijmul(mxjet+1);
   int ierr;
 
   // run pxcone
@@ -90,16 +93,16 @@ void PxConePlugin::run_clustering(fastjet::ClusterSequence & clust_seq) const {
     mode   ,    // 1=>e+e-, 2=>hadron-hadron
     ntrak  ,    // Number of particles
     itkdm  ,    // First dimension of PTRAK array: 
-    ptrak  ,    // Array of particle 4-momenta (Px,Py,Pz,E)
+    ptrak.data()  ,    // Array of particle 4-momenta (Px,Py,Pz,E)
     cone_radius()  ,    // Cone size (half angle) in radians
     min_jet_energy() ,    // Minimum Jet energy (GeV)
     overlap_threshold()  ,    // Maximum fraction of overlap energy in a jet
     mxjet  ,    // Maximum possible number of jets
     njet   ,    // Number of jets found
-    pjet ,       // 5-vectors of jets
-    ipass,      // Particle k belongs to jet number IPASS(k)-1
+    pjet.data() ,       // 5-vectors of jets
+    ipass.data(),      // Particle k belongs to jet number IPASS(k)-1
                 // IPASS = -1 if not assosciated to a jet
-    ijmul,      // Jet i contains IJMUL[i] particles
+    ijmul.data(),      // Jet i contains IJMUL[i] particles
     &ierr        // = 0 if all is OK ;   = -1 otherwise
     );
 
@@ -121,6 +124,8 @@ void PxConePlugin::run_clustering(fastjet::ClusterSequence & clust_seq) const {
   // which the jets are built up by adding one particle at a time
   for(int ipxjet = njet-1; ipxjet >= 0; ipxjet--) {
     const vector<int> & jet_trak_list = jet_particle_content[ipxjet];
+    // an empty jet can only survive with min_jet_energy <= 0
+    if (jet_trak_list.empty()) continue;
     int jet_k = jet_trak_list[0];
   
     for (unsigned ilist = 1; ilist < jet_trak_list.size(); ilist++) {
@@ -162,11 +167,6 @@ void PxConePlugin::run_clustering(fastjet::ClusterSequence & clust_seq) const {
   //  cout << ourjet->perp() << " " << ourjet->rap() << endl;
   //}
   ////cout << endl;
-
-  delete[] ptrak;
-  delete[] ipass;
-  delete[] ijmul;
-  delete[] pjet;
 }
 
 // print a banner for reference to the 3rd-party code
@@ -191,229 +191,429 @@ void PxConePlugin::_print_banner(ostream *ostr) const{
 
 // FASTJET_END_NAMESPACE      // defined in fastjet/internal/base.hh
 
-/* pxcone.f -- translated by f2c and hacked by Leif Lönnblad to avoid
-   linking with libf2c.
-*/
-
-//#include "Rivet/Projections/pxcone.h"
-using namespace std;
-
-/* Table of constant values, which are actually non const to be able
-   to be used as fortran arguments. */
-static int MAXV = 20000;
-static int VDIM = 3;
-
-void pxtry_(int, double *, int,  double *, double *, double *, double *, 
-	    double *, int *, int *);
 
-void pxsorv_(int, double *, int *, char);
-
-void pxsear_(int, double *, int, double *, double *, double *, int &, int *, 
-             double *, int *, int *);
-
-void pxolap_(int, int, int, int *, double *, double *, double);
+/* pxcone.f -- originally translated by f2c and hacked by Leif Lönnblad
+   to avoid linking with libf2c; since rewritten with dynamic storage.
+*/
 
-void pxnorv_(int *, double *, double *, int *);
+namespace {
 
 // The standard fortran SIGN function for doubles.
 inline double d_sign(double a, double b) {
   return b < 0.0? -fabs(a): fabs(a);
 }
 
-// The standard fortran MOD function for doubles.
-inline double d_mod(double a, double p) {
-  return a - int(a/p)*p;
-}
-
 /* ---RETURNS PHI, MOVED ONTO THE RANGE [-PI,PI) */
 inline double pxmdpi(double phi) {
   while ( phi <= -M_PI ) phi += 2*M_PI;
   while ( phi > M_PI ) phi -= 2*M_PI;
   return abs(phi) < 1e-15? 0.0: phi;
 }
-//   if (phi <= M_PI) {
-//     if (phi > -M_PI)
-//       return abs(phi) < 1e-15? 0.0: phi;
-//     else if (phi > -3*M_PI)
-//       phi += 2*M_PI;
-//     else
-//       phi = -d_mod(M_PI - phi, 2*M_PI) + M_PI;
-//   } else if (phi <= 3.0*M_PI) {
-//     phi -= 2*M_PI;
-//   } else {
-//     phi = d_mod(phi + M_PI, 2*M_PI) - M_PI;
-//   }
-
-//   return abs(phi) < 1e-15? 0.0: phi;
-
-// }
-
-/* Set integer vector a to zero */
-inline void pxzeri(int n, int *a){
-  for (int i = 0; i < n; ++i) a[i] = 0;
-}
-
-/* Set vector a to zero */
-inline void pxzerv(int n, double *a) {
-    for (int i = 0; i < n; ++i)	a[i] = 0.;
-}
-
-/* add vectors c = a + b */
-inline void pxaddv(int n, double *a, double *b, double *c) {
-  for (int i = 0; i < n; ++i) c[i] = a[i] + b[i];
-}
 
-bool pxuvec(int ntrak, double *pp, double *pu) {
-
-  /* Parameter adjustments */
-  pu -= 4;
-  pp -= 5;
-
-  for (int n = 1; n <= ntrak; ++n) {
-    double mag = 0.0;
-    for ( int mu = 1; mu <= 3; ++mu)
-      mag += pp[mu + (n << 2)]*pp[mu + (n << 2)];
-    mag = sqrt(mag);
-    if (mag == 0.0 ) {
-      printf(" PXCONE: An input particle has zero mod(p)\n");
-      return false;
-    }
-    for (int mu = 1; mu <= 3; ++mu)
-      pu[mu + n * 3] = pp[mu + (n << 2)] / mag;
-  }
-  return true;
+/* Normalise the 3-vector a into b, leaving b untouched if a is null */
+inline void pxnorv(const double *a, double *b) {
+  double c = 0.;
+  for (int i = 0; i < 3; ++i) c += a[i]*a[i];
+  if (c <= 0.) return;
+  c = 1/sqrt(c);
+  for (int i = 0; i < 3; ++i) b[i] = a[i]*c;
 }
 
 /* calculate angle between two vectors */
-void pxang3(double *a, double *b, double &cost, double &thet) {
-
+void pxang3(const double *a, const double *b, double &cost, double &thet) {
   cost = 1.0;
   thet = 0.0;
   double c = (a[0]*a[0] + a[1]*a[1] + a[2]*a[2])*
              (b[0]*b[0] + b[1]*b[1] + b[2]*b[2]);
   if (c <= 0.) return;
-  
+
   c = 1/sqrt(c);
   cost = (a[0]*b[0] + a[1]*b[1] + a[2]*b[2])*c;
   thet = acos(cost);
-  
 }
 
-/* ** Note that although JETLIS is assumed to be a 2d array, it */
-/* ** it is used as 1d in this routine for efficiency */
-/* ** Checks to see if TSTLIS entries correspond to a jet already found */
-/* ** and entered in JETLIS */
-int pxnew(int *tstlis, int *jetlis, int ntrak, int njet) {
 
-  int match;
-  for (int i = 0; i < njet; ++i) {
-    match = true;
-    int in = i - 5000;
+/// A stable cone: its momentum and the sorted indices of its particles.
+/// If MODE.EQ.2 the momentum is stored as (eta,phi,<empty>,pt).
+struct PxProtoJet {
+  double p[4];
+  vector<int> members;
+};
+
+
+/// One run of the pxcone algorithm.
+///
+/// Particles are held as structure-of-arrays (PP as four component
+/// vectors, PU as three) and proto-jets as particle-index lists, so
+/// nothing is limited in size. In eta-phi mode the particles are also
+/// indexed by phi, and a cone only tests those inside its phi window;
+/// candidates are still summed in input order so that the floating-point
+/// results are identical to the original full scan.
+class PxConeEngine {
+public:
+
+  PxConeEngine(int mode, double coner)
+    : _mode(mode), _coner(coner), _unstable(false)
+  {
+    if (_mode != 2) {
+      _cosr = cos(coner);
+      _cos2r = cos(coner);
+    } else {
+      /* ** Purely for convenience, work in terms of 1-R**2 */
+      _cosr = 1 - coner*coner;
+      /* MW -- select Rsep: 1-(Rsep*CONER)**2 */
+      const double rsep = 2.;
+      const double rsepr = rsep*coner;
+      _cos2r = 1 - rsepr*rsepr;
+    }
+    // The window needs a margin for rounding in the cone test, and is only
+    // worthwhile (and only excludes the |eta| >= 20 particles correctly)
+    // while it is narrower than the whole phi range.
+    _windowed = _mode == 2 && coner + PHI_MARGIN < M_PI;
+  }
+
+
+  /* ** Copy calling array PTRAK to the internal arrays PP and PU, */
+  /* ** converting to eta,phi,pt if necessary */
+  bool setParticles(int ntrak, int itkdm, const double *ptrak) {
+    _ntrak = ntrak;
+    for (int mu = 0; mu < 4; ++mu) _pp[mu].assign(ntrak, 0.);
+    for (int mu = 0; mu < 3; ++mu) _pu[mu].assign(ntrak, 0.);
+
     for (int n = 0; n < ntrak; ++n) {
-      in += 5000;
-      if (tstlis[n] != jetlis[in]) {
-        match = false;
-        break;
+      const double *p = ptrak + n*itkdm;
+      if (_mode != 2) {
+        for (int mu = 0; mu < 4; ++mu) _pp[mu][n] = p[mu];
+        continue;
+      }
+      const double ptsq = p[0]*p[0] + p[1]*p[1];
+      const double pplus = sqrt(ptsq + p[2]*p[2]) + abs(p[2]);
+      const double ppsq = pplus*pplus;
+      const double eta = ptsq <= ppsq * (float)4.25e-18 ? 20. : log(ppsq / ptsq) * (float).5;
+      _pp[0][n] = d_sign(eta, p[2]);
+      _pp[1][n] = ptsq == 0. ? 0. : atan2(p[1], p[0]);
+      _pp[2][n] = 0.;
+      _pp[3][n] = sqrt(ptsq);
+      for (int mu = 0; mu < 3; ++mu) _pu[mu][n] = _pp[mu][n];
+    }
+
+    if (_mode != 2) {
+      // Unit vectors along each particle direction
+      for (int n = 0; n < ntrak; ++n) {
+        double mag = 0.0;
+        for (int mu = 0; mu < 3; ++mu) mag += _pp[mu][n]*_pp[mu][n];
+        mag = sqrt(mag);
+        if (mag == 0.0) {
+          printf(" PXCONE: An input particle has zero mod(p)\n");
+          return false;
+        }
+        for (int mu = 0; mu < 3; ++mu) _pu[mu][n] = _pp[mu][n] / mag;
+      }
+    } else if (_windowed) {
+      // Phi index over the particles that can enter a cone at all
+      vector<pair<double,int> > byphi;
+      byphi.reserve(ntrak);
+      for (int n = 0; n < ntrak; ++n)
+        if (abs(_pu[0][n]) < 20.) byphi.push_back(make_pair(_pu[1][n], n));
+      sort(byphi.begin(), byphi.end());
+      _sortedPhi.resize(byphi.size());
+      _sortedIdx.resize(byphi.size());
+      for (size_t i = 0; i < byphi.size(); ++i) {
+        _sortedPhi[i] = byphi[i].first;
+        _sortedIdx[i] = byphi[i].second;
       }
     }
-    if (match) return false;
+    return true;
   }
-  return true;
-}
 
-/* ** Returns T if the first N elements of LIST1 are the same as the */
-/* ** first N elements of LIST2. */
-bool pxsame(int *list1, int *list2, int n) {
-  for (int i = 0; i < n; ++i)
-    if (list1[i] != list2[i])
-      return false;
-  return true;
-}
 
-/* ** Routine to put jets into order and eliminate tose less than EPSLON */
-/* ** Puts jets in order of energy: 1 = highest energy etc. */
-/* ** Then Eliminate jets with energy below EPSLON */
-void pxord(double epslon, int & njet, int ntrak,
-	 int *jetlis, double *pj)
-{
-    /* Local variables */
-    static int index[5000];
-    static double elist[5000], ptemp[20000]	/* was [4][5000] */;
-    static int logtmp[25000000]	/* was [5000][5000] */;
+  /* ** Look for jets using particle directions, then the midpoints of */
+  /* ** pairs of proto-jets, as seed axes */
+  void findProtoJets() {
+    double vseed[3], vec1[3], vec2[3];
+    for (int n = 0; n < _ntrak; ++n) {
+      for (int mu = 0; mu < 3; ++mu) vseed[mu] = _pu[mu][n];
+      _search(vseed);
+    }
+
+    // Seeds found here are themselves used as partners for later pairs,
+    // but not as the first member of a pair
+    const size_t nfirst = _jets.size();
+    for (size_t n1 = 0; n1+1 < nfirst; ++n1) {
+      for (int mu = 0; mu < 3; ++mu) vec1[mu] = _jets[n1].p[mu];
+      if (_mode != 2) pxnorv(vec1, vec1);
+      /*         DO 150 N2 = N1+1,NJTORG ! GPS -- to get consistent behaviour */
+      const size_t n2end = _jets.size();
+      for (size_t n2 = n1+1; n2 < n2end; ++n2) {
+        for (int mu = 0; mu < 3; ++mu) vec2[mu] = _jets[n2].p[mu];
+        if (_mode != 2) pxnorv(vec2, vec2);
+        for (int mu = 0; mu < 3; ++mu) vseed[mu] = vec1[mu] + vec2[mu];
+        if (_mode != 2) {
+          pxnorv(vseed, vseed);
+        } else {
+          vseed[0] /= 2;
+          /* GPS 25/02/07 */
+          vseed[1] = pxmdpi(vec1[1] + pxmdpi(vec2[1] - vec1[1]) * .5);
+        }
+        /* ---ONLY BOTHER IF THEY ARE BETWEEN 1 AND 2 CONE RADII APART */
+        double cosval;
+        if (_mode != 2) {
+          cosval = vec1[0]*vec2[0] + vec1[1]*vec2[1] + vec1[2]*vec2[2];
+        } else if (abs(vec1[0]) >= 20. || abs(vec2[0]) >= 20.) {
+          cosval = -1e3;
+        } else {
+          const double deta = vec1[0] - vec2[0];
+          const double dphi = pxmdpi(vec1[1] - vec2[1]);
+          cosval = 1 - (deta*deta + dphi*dphi);
+        }
+        if (cosval <= _cosr && cosval >= _cos2r) _search(vseed);
+      }
+    }
+  }
 
 
+  /// Did any seed fail to converge within the iteration limit?
+  bool unstable() const { return _unstable; }
 
-/* ** Copy input arrays. */
-    /* Parameter adjustments */
-    pj -= 5;
-    jetlis -= 5001;
 
-    /* Function Body */
-    for (int i = 1; i <= njet; ++i) {
-      for (int j = 1; j <= 4; ++j) {
-        ptemp[j + (i << 2) - 5] = pj[j + (i << 2)];
-      }
-      for (int j = 1; j <= ntrak; ++j) {
-        logtmp[i + j * 5000 - 5001] = jetlis[i + j * 5000];
+  /* ** Put jets in order of energy: 1 = highest energy etc. */
+  /* ** Then eliminate jets with energy below EPSLON */
+  void order(double epslon) {
+    // NB. ties keep their order of discovery, as in PXSORV
+    stable_sort(_jets.begin(), _jets.end(),
+                [](const PxProtoJet& a, const PxProtoJet& b) { return a.p[3] > b.p[3]; });
+    while (!_jets.empty() && _jets.back().p[3] < epslon) _jets.pop_back();
+  }
+
+
+  /* ** Looks for particles assigned to more than 1 jet, and reassigns them */
+  /* ** If more than a fraction OVLIM of a jet's energy is contained in */
+  /* ** higher energy jets, that jet is neglected. */
+  /* ** Particles assigned to the jet closest in angle (a la CDF, Snowmass). */
+  void resolveOverlaps(double ovlim) {
+    const size_t njet = _jets.size();
+    if (njet <= 1) return;
+
+    /* ** Look for jets with large overlaps with higher energy jets. */
+    vector<char> inhigher(_ntrak, false);
+    for (int n : _jets[0].members) inhigher[n] = true;
+    for (size_t i = 1; i < njet; ++i) {
+      vector<int>& members = _jets[i].members;
+      double eover = (float)0.;
+      for (int n : members)
+        if (inhigher[n]) eover += _pp[3][n];
+      /* ** De-assign all particles from the jet if the shared fraction is too large */
+      if (eover > ovlim * _jets[i].p[3]) members.clear();
+      for (int n : members) inhigher[n] = true;
+    }
+
+    /* ** Any particles now in more than 1 jet are assigned to the CLOSEST */
+    /* ** jet (in angle). */
+    vector<int> owner(_ntrak, -1);
+    vector<double> thmin(_ntrak);
+    vector<char> shared(_ntrak, false);
+    for (size_t j = 0; j < njet; ++j) {
+      for (int n : _jets[j].members) {
+        if (owner[n] < 0) {
+          owner[n] = j;
+          continue;
+        }
+        if (!shared[n]) {
+          thmin[n] = _angle(n, _jets[owner[n]].p);
+          shared[n] = true;
+        }
+        const double thet = _angle(n, _jets[j].p);
+        if (thet < thmin[n]) {
+          thmin[n] = thet;
+          owner[n] = j;
+        }
       }
     }
-    for (int i = 1; i <= njet; ++i) {
-      elist[i - 1] = pj[(i << 2) + 4];
+    for (size_t j = 0; j < njet; ++j) _jets[j].members.clear();
+    for (int n = 0; n < _ntrak; ++n)
+      if (owner[n] >= 0) _jets[owner[n]].members.push_back(n);
+
+    /* ** Recompute PJ */
+    for (size_t i = 0; i < njet; ++i) {
+      double* pj = _jets[i].p;
+      for (int mu = 0; mu < 4; ++mu) pj[mu] = (float)0.;
+      for (int n : _jets[i].members) _addParticle(pj, n);
     }
-    
-/* ** Sort the energies... */
-    pxsorv_(njet, elist, index, 'I');
-/* ** Fill PJ and JETLIS according to sort ( sort is in ascending order!!) */
-    for (int i = 1; i <= njet; ++i) {
-	for (int j = 1; j <= 4; ++j) {
-	    pj[j + (i << 2)] = ptemp[j + (index[njet + 1 - i - 1] << 2) - 5];
-	}
-	for (int j = 1; j <= ntrak; ++j) {
-	    jetlis[i + j * 5000] =
-              logtmp[index[njet + 1 - i - 1] + j *  5000 - 5001];
-	}
+  }
+
+
+  /// The proto-jets found, in their current order
+  const vector<PxProtoJet>& jets() const { return _jets; }
+
+
+private:
+
+  /// Extra half-width of the phi window, absorbing rounding in the cone test
+  static constexpr double PHI_MARGIN = 1e-7;
+
+
+  /* ** Add particle N to the running jet momentum PJ */
+  void _addParticle(double *pj, int n) const {
+    if (_mode != 2) {
+      for (int mu = 0; mu < 4; ++mu) pj[mu] += _pp[mu][n];
+      return;
     }
-/* * Jets are now in order */
-/* ** Now eliminate jets with less than Epsilon energy */
-    int nold = njet;
-    for (int i = 1; i <= nold; ++i) {
-	if (pj[(i << 2) + 4] < epslon) {
-	    --njet;
-	    pj[(i << 2) + 4] = 0.0;
-	}
+    const double pt = _pp[3][n];
+    pj[0] += pt / (pt + pj[3]) * (_pp[0][n] - pj[0]);
+    /* GPS 25/02/07 */
+    pj[1] = pxmdpi(pj[1] + pt / (pt + pj[3]) * pxmdpi(_pp[1][n] - pj[1]));
+    pj[3] += pt;
+  }
+
+
+  /* ** Angular distance (or distance squared in eta-phi) of particle N */
+  /* ** from the axis of jet momentum PJ */
+  double _angle(int n, const double *pj) const {
+    const double vec1[3] = { _pp[0][n], _pp[1][n], _pp[2][n] };
+    double cost, thet;
+    if (_mode != 2) {
+      pxang3(vec1, pj, cost, thet);
+    } else {
+      const double deta = vec1[0] - pj[0];
+      const double dphi = pxmdpi(vec1[1] - pj[1]);
+      thet = deta*deta + dphi*dphi;
     }
-}
+    return thet;
+  }
 
-// The main PXCONE function.
-void pxcone_(int mode, int ntrak, int itkdm, 
-	const double *ptrak, double coner, double epslon, double
-	ovlim, int mxjet, int & njet, double *pjet, int *
-	ipass, int *ijmul, int *ierr)
-{
-    /* Initialized data */
 
-    static set<double> rold;
-    static set<double> epsold;
-    static set<double> ovold;
+  /* ** Fill _cand with the particles inside the cone about OAXIS, testing */
+  /* ** only those within its phi window, and return them in input order */
+  void _window(const double *oaxis) {
+    _cand.clear();
+    const double w = _coner + PHI_MARGIN;
+    const double lo = oaxis[1] - w, hi = oaxis[1] + w;
+    _appendRange(oaxis, max(lo, -M_PI), min(hi, M_PI));
+    if (lo < -M_PI) _appendRange(oaxis, lo + 2*M_PI, M_PI);
+    if (hi > M_PI) _appendRange(oaxis, -M_PI, hi - 2*M_PI);
+    sort(_cand.begin(), _cand.end());
+  }
+
+  void _appendRange(const double *oaxis, double lo, double hi) {
+    const size_t first = lower_bound(_sortedPhi.begin(), _sortedPhi.end(), lo) - _sortedPhi.begin();
+    for (size_t i = first; i < _sortedPhi.size() && _sortedPhi[i] <= hi; ++i)
+      if (_inCone(oaxis, _sortedIdx[i])) _cand.push_back(_sortedIdx[i]);
+  }
+
+
+  /* ** Is particle N inside the cone about OAXIS? */
+  bool _inCone(const double *oaxis, int n) const {
+    double cosval;
+    if (_mode != 2) {
+      cosval = (float)0.;
+      for (int mu = 0; mu < 3; ++mu) cosval += oaxis[mu] * _pu[mu][n];
+    } else if (abs(_pu[0][n]) >= 20. || abs(oaxis[0]) >= 20.) {
+      cosval = -1e3;
+    } else {
+      const double deta = oaxis[0] - _pu[0][n];
+      const double dphi = pxmdpi(oaxis[1] - _pu[1][n]);
+      cosval = 1 - (deta*deta + dphi*dphi);
+    }
+    return cosval >= _cosr;
+  }
+
+
+  /* ** Finds all particles in cone of size COSR about OAXIS direction. */
+  /* ** Calculates 4-momentum sum of all particles in cone (PNEW) , and */
+  /* ** returns this as new jet axis NAXIS (Both unit Vectors) */
+  bool _try(const double *oaxis, double *naxis, double *pnew, vector<int>& newlis) {
+    newlis.clear();
+    for (int mu = 0; mu < 4; ++mu) pnew[mu] = (float)0.;
+
+    if (_windowed) {
+      // Nothing at |eta| >= 20 can be inside the cone
+      if (abs(oaxis[0]) >= 20.) return false;
+      _window(oaxis);
+      for (int n : _cand) {
+        newlis.push_back(n);
+        _addParticle(pnew, n);
+      }
+    } else {
+      for (int n = 0; n < _ntrak; ++n) {
+        if (!_inCone(oaxis, n)) continue;
+        newlis.push_back(n);
+        _addParticle(pnew, n);
+      }
+    }
+    if (newlis.empty()) return false;
+
+    /* ** If there are particles in the cone, calc new jet axis */
+    double norm = 1.;
+    if (_mode != 2) {
+      double normsq = (float)0.;
+      for (int mu = 0; mu < 3; ++mu) normsq += pnew[mu]*pnew[mu];
+      norm = sqrt(normsq);
+    }
+    for (int mu = 0; mu < 3; ++mu) naxis[mu] = pnew[mu] / norm;
+    return true;
+  }
+
+
+  /* ** Using VSEED as a trial axis , look for a stable jet. */
+  /* ** Check stable jets against those already found and add to the list. */
+  /* ** Will try up to MXITER iterations to get a stable set of particles */
+  /* ** in the cone. */
+  void _search(const double *vseed) {
+    const int mxiter = 30;
+    double oaxis[3], naxis[3], pnew[4];
+    for (int mu = 0; mu < 3; ++mu) oaxis[mu] = vseed[mu];
+    _oldlis.clear();
+    for (int iter = 0; iter < mxiter; ++iter) {
+      /* ** Return immediately if there were no particles in the cone. */
+      if (!_try(oaxis, naxis, pnew, _newlis)) return;
+      if (_newlis == _oldlis) {
+        /* ** We have a stable jet: add it if it is a new one. */
+        for (const PxProtoJet& jet : _jets)
+          if (jet.members == _newlis) return;
+        _jets.push_back(PxProtoJet());
+        for (int mu = 0; mu < 4; ++mu) _jets.back().p[mu] = pnew[mu];
+        _jets.back().members = _newlis;
+        return;
+      }
+      /* ** The jet was not stable, so we iterate again */
+      swap(_oldlis, _newlis);
+      for (int mu = 0; mu < 3; ++mu) oaxis[mu] = naxis[mu];
+    }
+    _unstable = true;
+  }
+
+
+  int _mode;
+  double _coner, _cosr, _cos2r;
+  bool _windowed, _unstable;
+
+  /// Particle momenta PP and directions PU, one vector per component
+  int _ntrak = 0;
+  vector<double> _pp[4], _pu[3];
+
+  /// Phi-ordered index of the particles with |eta| < 20 (eta-phi mode)
+  vector<double> _sortedPhi;
+  vector<int> _sortedIdx;
+
+  /// Proto-jets found so far
+  vector<PxProtoJet> _jets;
+
+  /// Scratch lists reused between cone trials
+  vector<int> _cand, _oldlis, _newlis;
+
+};
 
-    /* System generated locals */
-    int ptrak_dim1, ptrak_offset, i__1, i__2;
-    double d__1, d__2, d__3;
-
-    /* Local variables */
-    static double cosr, rsep, ppsq, ptsq, cos2r;
-    static int i__, j, n;
-    static double vseed[3];
-    static int iterr;
-    static int n1, n2;
-    static double pj[20000]	/* was [4][5000] */, pp[20000]	/* was [4][
-	    5000] */;
-    static int mu;
-    static double pu[15000]	/* was [3][5000] */, cosval;
-    static int jetlis[25000000]	/* was [5000][5000] */;
-    static int unstbl;
-    static double vec1[3], vec2[3];
+constexpr double PxConeEngine::PHI_MARGIN;
 
+}
+
+
+// The main PXCONE function.
+void pxcone_(int mode, int ntrak, int itkdm,
+        const double *ptrak, double coner, double epslon, double
+        ovlim, int mxjet, int & njet, double *pjet, int *
+        ipass, int *ijmul, int *ierr)
+{
 /* .********************************************************* */
 /* . ------ */
 /* . PXCONE */
@@ -477,6 +677,8 @@ void pxcone_(int mode, int ntrak, int itkdm,
 /* . LAST MOD  :   2-Mar-93 */
 /* . */
 /* . Modification Log. */
+/* . 19-Oct-26: Rivet       - C++ rewrite: dynamic storage in place of the */
+/* .                          MXTRAK/MXPROT arrays, phi-sorted cone search */
 /* . 25-Feb-07: G P Salam   - fix bugs concerning 2pi periodicity in eta phi mode */
 /* .                        - added commented code to get consistent behaviour */
 /* .                          regardless of particle order (replaces n-way */
@@ -492,29 +694,14 @@ void pxcone_(int mode, int ntrak, int itkdm,
 /* . 1-Mar-93: L A del Pozo - Add Print out of welcome and R and Epsilon */
 /* . */
 /* .********************************************************* */
-/* +SEQ,DECLARE. */
-/* ** External Arrays */
-/* ** Internal Arrays */
-/* ** Used in the routine. */
-/* MWobisch */
-/* MWobisch */
-    /* Parameter adjustments */
-    --ipass;
-    ptrak_dim1 = itkdm;
-    ptrak_offset = 1 + ptrak_dim1 * 1;
-    ptrak -= ptrak_offset;
-    --ijmul;
-    pjet -= 6;
-
-    /* Function Body */
-/* MWobisch */
-/* *************************************** */
-    rsep = 2.;
-/* *************************************** */
-/* MWobisch */
-    *ierr = 0;
 
-/* ** INITIALIZE */
+    static set<double> rold;
+    static set<double> epsold;
+    static set<double> ovold;
+
+    *ierr = 0;
+    njet = 0;
+    for (int j = 0; j < mxjet; ++j) ijmul[j] = 0;
 
 /* ** Print welcome and Jetfinder parameters */
     if ((rold.find(coner) == rold.end() ||
@@ -537,685 +724,56 @@ void pxcone_(int mode, int ntrak, int itkdm,
       ovold.insert(ovlim);
     }
 
-/* ** Copy calling array PTRAK  to internal array PP(4,NTRAK) */
-
-    if (ntrak > 5000) {
-/*         WRITE (6,*) ' PXCONE: Ntrak too large: ',NTRAK */
-      printf("%s%d\n", " PXCONE: Ntrak too large: ", ntrak);
-	*ierr = -1;
-	return;
-    }
-    if (mode != 2) {
-	i__1 = ntrak;
-	for (i__ = 1; i__ <= i__1; ++i__) {
-	    for (j = 1; j <= 4; ++j) {
-		pp[j + (i__ << 2) - 5] = ptrak[j + i__ * ptrak_dim1];
-	    }
-	}
-    } else {
-/* ** Converting to eta,phi,pt if necessary */
-	i__1 = ntrak;
-	for (i__ = 1; i__ <= i__1; ++i__) {
-/* Computing 2nd power */
-	    d__1 = ptrak[i__ * ptrak_dim1 + 1];
-/* Computing 2nd power */
-	    d__2 = ptrak[i__ * ptrak_dim1 + 2];
-	    ptsq = d__1 * d__1 + d__2 * d__2;
-/* Computing 2nd power */
-	    d__3 = ptrak[i__ * ptrak_dim1 + 3];
-/* Computing 2nd power */
-	    d__2 = sqrt(ptsq + d__3 * d__3) + (d__1 = ptrak[i__ * ptrak_dim1 
-		    + 3], abs(d__1));
-	    ppsq = d__2 * d__2;
-	    if (ptsq <= ppsq * (float)4.25e-18) {
-		pp[(i__ << 2) - 4] = 20.;
-	    } else {
-		pp[(i__ << 2) - 4] = log(ppsq / ptsq) * (float).5;
-	    }
-	    pp[(i__ << 2) - 4] = d_sign(pp[(i__ << 2) - 4], ptrak[i__ * 
-		    ptrak_dim1 + 3]);
-	    if (ptsq == 0.) {
-		pp[(i__ << 2) - 3] = 0.;
-	    } else {
-		pp[(i__ << 2) - 3] = atan2(ptrak[i__ * ptrak_dim1 + 2], ptrak[
-			i__ * ptrak_dim1 + 1]);
-	    }
-	    pp[(i__ << 2) - 2] = 0.;
-	    pp[(i__ << 2) - 1] = sqrt(ptsq);
-	    pu[i__ * 3 - 3] = pp[(i__ << 2) - 4];
-	    pu[i__ * 3 - 2] = pp[(i__ << 2) - 3];
-	    pu[i__ * 3 - 1] = pp[(i__ << 2) - 2];
-	}
-    }
-
-/* ** Zero output variables */
-
-    njet = 0;
-    i__1 = ntrak;
-    for (i__ = 1; i__ <= i__1; ++i__) {
-	for (j = 1; j <= 5000; ++j) {
-	    jetlis[j + i__ * 5000 - 5001] = false;
-	}
+    PxConeEngine engine(mode, coner);
+    if (!engine.setParticles(ntrak, itkdm, ptrak)) {
+      *ierr = 1;
+      return;
     }
-    pxzerv(MAXV, pj);
-    pxzeri(mxjet, &ijmul[1]);
 
-    if (mode != 2) {
-	cosr = cos(coner);
-	cos2r = cos(coner);
-    } else {
-/* ** Purely for convenience, work in terms of 1-R**2 */
-/* Computing 2nd power */
-	d__1 = coner;
-	cosr = 1 - d__1 * d__1;
-/* MW -- select Rsep: 1-(Rsep*CONER)**2 */
-/* Computing 2nd power */
-	d__1 = rsep * coner;
-	cos2r = 1 - d__1 * d__1;
-/* ORIGINAL         COS2R =  1-(2*CONER)**2 */
-    }
-    unstbl = false;
-    if (mode != 2) {
-      if ( !pxuvec(ntrak, pp, pu) ) {
-        *ierr = 1;
-        return;
-      }
-    }
-/* ** Look for jets using particle diretions as seed axes */
-
-    i__1 = ntrak;
-    for (n = 1; n <= i__1; ++n) {
-	for (mu = 1; mu <= 3; ++mu) {
-	    vseed[mu - 1] = pu[mu + n * 3 - 4];
-	}
-	pxsear_(mode, &cosr, ntrak, pu, pp, vseed, njet, jetlis, pj, &unstbl, 
-		ierr);
-	if (*ierr != 0) {
-	    return;
-	}
+    engine.findProtoJets();
+    if (engine.unstable()) {
+      *ierr = -1;
+      printf(" PXCONE: Too many iterations to find a proto-jet\n");
+      return;
     }
 
-    i__1 = njet - 1;
-    for (n1 = 1; n1 <= i__1; ++n1) {
-	vec1[0] = pj[(n1 << 2) - 4];
-	vec1[1] = pj[(n1 << 2) - 3];
-	vec1[2] = pj[(n1 << 2) - 2];
-	if (mode != 2) {
-	    pxnorv_(&VDIM, vec1, vec1, &iterr);
-	}
-/*         DO 150 N2 = N1+1,NJTORG ! GPS -- to get consistent behaviour */
-	i__2 = njet;
-	for (n2 = n1 + 1; n2 <= i__2; ++n2) {
-	    vec2[0] = pj[(n2 << 2) - 4];
-	    vec2[1] = pj[(n2 << 2) - 3];
-	    vec2[2] = pj[(n2 << 2) - 2];
-	    if (mode != 2) {
-		pxnorv_(&VDIM, vec2, vec2, &iterr);
-	    }
-	    pxaddv(VDIM, vec1, vec2, vseed);
-	    if (mode != 2) {
-		pxnorv_(&VDIM, vseed, vseed, &iterr);
-	    } else {
-		vseed[0] /= 2;
-/* VSEED(2)=VSEED(2)/2 */
-/* GPS 25/02/07 */
-		d__2 = vec2[1] - vec1[1];
-		d__1 = vec1[1] + pxmdpi(d__2) * .5;
-		vseed[1] = pxmdpi(d__1);
-	    }
-/* ---ONLY BOTHER IF THEY ARE BETWEEN 1 AND 2 CONE RADII APART */
-	    if (mode != 2) {
-		cosval = vec1[0] * vec2[0] + vec1[1] * vec2[1] + vec1[2] * 
-			vec2[2];
-	    } else {
-		if (abs(vec1[0]) >= 20. || abs(vec2[0]) >= 20.) {
-		    cosval = -1e3;
-		} else {
-/* Computing 2nd power */
-		    d__1 = vec1[0] - vec2[0];
-		    d__3 = vec1[1] - vec2[1];
-/* Computing 2nd power */
-		    d__2 = pxmdpi(d__3);
-		    cosval = 1 - (d__1 * d__1 + d__2 * d__2);
-		}
-	    }
-	    if (cosval <= cosr && cosval >= cos2r) {
-		pxsear_(mode, &cosr, ntrak, pu, pp, vseed, njet, jetlis, pj, &
-			unstbl, ierr);
-	    }
-/*            CALL PXSEAR(MODE,COSR,NTRAK,PU,PP,VSEED,NJET, */
-/*     +           JETLIS,PJ,UNSTBL,IERR) */
-	    if (*ierr != 0) {
-		return;
-	    }
-	}
-    }
-    if (unstbl) {
-	*ierr = -1;
-/*        WRITE (6,*) ' PXCONE: Too many iterations to find a proto-jet' */
-        printf(" PXCONE: Too many iterations to find a proto-jet\n");
-	return;
-    }
 /* ** Now put the jet list into order by jet energy, eliminating jets */
 /* ** with energy less than EPSLON. */
-    pxord(epslon, njet, ntrak, jetlis, pj);
+    engine.order(epslon);
 
 /* ** Take care of jet overlaps */
-    pxolap_(mode, njet, ntrak, jetlis, pj, pp, ovlim);
+    engine.resolveOverlaps(ovlim);
 
 /* ** Order jets again as some have been eliminated, or lost energy. */
-    pxord(epslon, njet, ntrak, jetlis, pj);
+    engine.order(epslon);
 
 /* ** All done!, Copy output into output arrays */
+    const vector<PxProtoJet>& jets = engine.jets();
+    njet = jets.size();
     if (njet > mxjet) {
-/*         WRITE (6,*) ' PXCONE:  Found more than MXJET jets' */
       printf(" PXCONE:  Found more than MXJET jets\n");
-	*ierr = -1;
-	goto L99;
+      *ierr = -1;
+      return;
     }
-    if (mode != 2) {
-	i__1 = njet;
-	for (i__ = 1; i__ <= i__1; ++i__) {
-	    for (j = 1; j <= 4; ++j) {
-		pjet[j + i__ * 5] = pj[j + (i__ << 2) - 5];
-	    }
-	}
-    } else {
-	i__1 = njet;
-	for (i__ = 1; i__ <= i__1; ++i__) {
-	    pjet[i__ * 5 + 1] = pj[(i__ << 2) - 1] * cos(pj[(i__ << 2) - 3]);
-	    pjet[i__ * 5 + 2] = pj[(i__ << 2) - 1] * sin(pj[(i__ << 2) - 3]);
-	    pjet[i__ * 5 + 3] = pj[(i__ << 2) - 1] * sinh(pj[(i__ << 2) - 4]);
-	    pjet[i__ * 5 + 4] = pj[(i__ << 2) - 1] * cosh(pj[(i__ << 2) - 4]);
-	}
+    for (int i = 0; i < njet; ++i) {
+      const double *pj = jets[i].p;
+      if (mode != 2) {
+        for (int j = 0; j < 4; ++j) pjet[5*i + j] = pj[j];
+      } else {
+        pjet[5*i + 0] = pj[3] * cos(pj[1]);
+        pjet[5*i + 1] = pj[3] * sin(pj[1]);
+        pjet[5*i + 2] = pj[3] * sinh(pj[0]);
+        pjet[5*i + 3] = pj[3] * cosh(pj[0]);
+      }
     }
-    i__1 = ntrak;
-    for (i__ = 1; i__ <= i__1; ++i__) {
-	ipass[i__] = -1;
-	i__2 = njet;
-	for (j = 1; j <= i__2; ++j) {
-	    if (jetlis[j + i__ * 5000 - 5001]) {
-		++ijmul[j];
-		ipass[i__] = j;
-	    }
-	}
+    for (int n = 0; n < ntrak; ++n) ipass[n] = -1;
+    for (int i = 0; i < njet; ++i) {
+      for (int n : jets[i].members) {
+        ++ijmul[i];
+        ipass[n] = i + 1;
+      }
     }
-L99:
-    return;
 } /* pxcone_ */
 
 
-void pxnorv_(int *n, double *a, double *b, int *iterr)
-{
-    /* System generated locals */
-    int i__1;
-    double d__1;
-
-    /* Builtin functions */
-
-    /* Local variables */
-    static double c__;
-    static int i__;
-
-    /* Parameter adjustments */
-    --b;
-    --a;
-
-    /* Function Body */
-    c__ = 0.;
-    i__1 = *n;
-    for (i__ = 1; i__ <= i__1; ++i__) {
-/* Computing 2nd power */
-	d__1 = a[i__];
-	c__ += d__1 * d__1;
-    }
-    if (c__ <= 0.) {
-	return;
-    }
-    c__ = 1 / sqrt(c__);
-    i__1 = *n;
-    for (i__ = 1; i__ <= i__1; ++i__) {
-	b[i__] = a[i__] * c__;
-    }
-    return;
-} /* pxnorv_ */
-
-
-void pxolap_(int mode, int njet, int ntrak, 
-	int *jetlis, double *pj, double *pp, double ovlim)
-{
-    /* Initialized data */
-
-    static int ijmin = 0;
-
-    /* System generated locals */
-    int i__1, i__2, i__3;
-    double d__1, d__2, d__3;
-
-    /* Local variables */
-    static int ijet[5000];
-    static double thet, cost;
-    static int i__, j, n;
-    static double eover, thmin;
-    static int nj, mu;
-    static int ovelap;
-    static double vec1[3], vec2[3];
-
-
-/* ** Looks for particles assigned to more than 1 jet, and reassigns them */
-/* ** If more than a fraction OVLIM of a jet's energy is contained in */
-/* ** higher energy jets, that jet is neglected. */
-/* ** Particles assigned to the jet closest in angle (a la CDF, Snowmass). */
-/* +SEQ,DECLARE. */
-    /* Parameter adjustments */
-    pp -= 5;
-    pj -= 5;
-    jetlis -= 5001;
-
-    /* Function Body */
-
-    if (njet <= 1) {
-	return;
-    }
-/* ** Look for jets with large overlaps with higher energy jets. */
-    i__1 = njet;
-    for (i__ = 2; i__ <= i__1; ++i__) {
-/* ** Find overlap energy between jets I and all higher energy jets. */
-	eover = (float)0.;
-	i__2 = ntrak;
-	for (n = 1; n <= i__2; ++n) {
-	    ovelap = false;
-	    i__3 = i__ - 1;
-	    for (j = 1; j <= i__3; ++j) {
-		if (jetlis[i__ + n * 5000] && jetlis[j + n * 5000]) {
-		    ovelap = true;
-		}
-	    }
-	    if (ovelap) {
-		eover += pp[(n << 2) + 4];
-	    }
-	}
-/* ** Is the fraction of energy shared larger than OVLIM? */
-	if (eover > ovlim * pj[(i__ << 2) + 4]) {
-/* ** De-assign all particles from Jet I */
-	    i__2 = ntrak;
-	    for (n = 1; n <= i__2; ++n) {
-		jetlis[i__ + n * 5000] = false;
-	    }
-	}
-    }
-/* ** Now there are no big overlaps, assign every particle in */
-/* ** more than 1 jet to the closet jet. */
-/* ** Any particles now in more than 1 jet are assigned to the CLOSET */
-/* ** jet (in angle). */
-    i__1 = ntrak;
-    for (i__ = 1; i__ <= i__1; ++i__) {
-	nj = 0;
-	i__2 = njet;
-	for (j = 1; j <= i__2; ++j) {
-	    if (jetlis[j + i__ * 5000]) {
-		++nj;
-		ijet[nj - 1] = j;
-	    }
-	}
-	if (nj > 1) {
-/* ** Particle in > 1 jet - calc angles... */
-	    vec1[0] = pp[(i__ << 2) + 1];
-	    vec1[1] = pp[(i__ << 2) + 2];
-	    vec1[2] = pp[(i__ << 2) + 3];
-	    thmin = (float)0.;
-	    i__2 = nj;
-	    for (j = 1; j <= i__2; ++j) {
-		vec2[0] = pj[(ijet[j - 1] << 2) + 1];
-		vec2[1] = pj[(ijet[j - 1] << 2) + 2];
-		vec2[2] = pj[(ijet[j - 1] << 2) + 3];
-		if (mode != 2) {
-		    pxang3(vec1, vec2, cost, thet);
-		} else {
-/* Computing 2nd power */
-		    d__1 = vec1[0] - vec2[0];
-		    d__3 = vec1[1] - vec2[1];
-/* Computing 2nd power */
-		    d__2 = pxmdpi(d__3);
-		    thet = d__1 * d__1 + d__2 * d__2;
-		}
-		if (j == 1) {
-		    thmin = thet;
-		    ijmin = ijet[j - 1];
-		} else if (thet < thmin) {
-		    thmin = thet;
-		    ijmin = ijet[j - 1];
-		}
-	    }
-/* ** Assign track to IJMIN */
-	    i__2 = njet;
-	    for (j = 1; j <= i__2; ++j) {
-		jetlis[j + i__ * 5000] = false;
-	    }
-	    jetlis[ijmin + i__ * 5000] = true;
-	}
-    }
-/* ** Recompute PJ */
-    i__1 = njet;
-    for (i__ = 1; i__ <= i__1; ++i__) {
-	for (mu = 1; mu <= 4; ++mu) {
-	    pj[mu + (i__ << 2)] = (float)0.;
-	}
-	i__2 = ntrak;
-	for (n = 1; n <= i__2; ++n) {
-	    if (jetlis[i__ + n * 5000]) {
-		if (mode != 2) {
-		    for (mu = 1; mu <= 4; ++mu) {
-			pj[mu + (i__ << 2)] += pp[mu + (n << 2)];
-		    }
-		} else {
-		    pj[(i__ << 2) + 1] += pp[(n << 2) + 4] / (pp[(n << 2) + 4]
-			     + pj[(i__ << 2) + 4]) * (pp[(n << 2) + 1] - pj[(
-			    i__ << 2) + 1]);
-/* GPS 25/02/07 */
-		    d__2 = pp[(n << 2) + 2] - pj[(i__ << 2) + 2];
-		    d__1 = pj[(i__ << 2) + 2] + pp[(n << 2) + 4] / (pp[(n << 
-			    2) + 4] + pj[(i__ << 2) + 4]) * pxmdpi(d__2);
-		    pj[(i__ << 2) + 2] = pxmdpi(d__1);
-/*                PJ(2,I)=PJ(2,I) */
-/*     +               + PP(4,N)/(PP(4,N)+PJ(4,I))*PXMDPI(PP(2,N)-PJ(2,I)) */
-		    pj[(i__ << 2) + 4] += pp[(n << 2) + 4];
-		}
-	    }
-	}
-    }
-    return;
-} /* pxolap_ */
-
-
-/* ******************************************************************* */
-void pxsear_(int mode, double *cosr, int ntrak, 
-             double *pu, double *pp, double *vseed, int & njet, 
-             int *jetlis, double *pj, int *unstbl, int *ierr)
-{
-    /* System generated locals */
-    int i__1;
-
-    /* Local variables */
-    static int iter;
-    static double pnew[4];
-    static int n;
-    static double naxis[3], oaxis[3];
-    static int ok;
-    static int mu;
-    static int oldlis[5000];
-    static int newlis[5000];
-
-
-/* +SEQ,DECLARE. */
-/* ** Using VSEED as a trial axis , look for a stable jet. */
-/* ** Check stable jets against those already found and add to PJ. */
-/* ** Will try up to MXITER iterations to get a stable set of particles */
-/* ** in the cone. */
-
-    /* Parameter adjustments */
-    pj -= 5;
-    jetlis -= 5001;
-    --vseed;
-    pp -= 5;
-    pu -= 4;
-
-    /* Function Body */
-    for (mu = 1; mu <= 3; ++mu) {
-	oaxis[mu - 1] = vseed[mu];
-    }
-    i__1 = ntrak;
-    for (n = 1; n <= i__1; ++n) {
-	oldlis[n - 1] = false;
-    }
-    for (iter = 1; iter <= 30; ++iter) {
-	pxtry_(mode, cosr, ntrak, &pu[4], &pp[5], oaxis, naxis, pnew, newlis, 
-		&ok);
-/* ** Return immediately if there were no particles in the cone. */
-	if (! ok) {
-	    return;
-	}
-	if (pxsame(newlis, oldlis, ntrak)) {
-/* ** We have a stable jet. */
-	    if (pxnew(newlis, &jetlis[5001], ntrak, njet)) {
-/* ** And the jet is a new one. So add it to our arrays. */
-/* ** Check arrays are big anough... */
-		if (njet == 5000) {
-/*             WRITE (6,*) ' PXCONE:  Found more than MXPROT proto-jets' */
-                  printf(" PXCONE:  Found more than MXPROT proto-jets\n");
-		    *ierr = -1;
-		    return;
-		}
-		++njet;
-		i__1 = ntrak;
-		for (n = 1; n <= i__1; ++n) {
-		    jetlis[njet + n * 5000] = newlis[n - 1];
-		}
-		for (mu = 1; mu <= 4; ++mu) {
-		    pj[mu + (njet << 2)] = pnew[mu - 1];
-		}
-	    }
-	    return;
-	}
-/* ** The jet was not stable, so we iterate again */
-	i__1 = ntrak;
-	for (n = 1; n <= i__1; ++n) {
-	    oldlis[n - 1] = newlis[n - 1];
-	}
-	for (mu = 1; mu <= 3; ++mu) {
-	    oaxis[mu - 1] = naxis[mu - 1];
-	}
-    }
-    *unstbl = true;
-    return;
-} /* pxsear_ */
-
-
-void pxsorv_(int n, double *a, int *k, char opt)
-{
-    /* System generated locals */
-    int i__1;
-
-
-    /* Local variables */
-    static double b[5000];
-    static int i__, j, il[5000], ir[5000];
-
-/*     Sort A(N) into ascending order */
-/*     OPT = 'I' : return index array K only */
-/*     OTHERWISE : return sorted A and index array K */
-/* ----------------------------------------------------------------------- */
-
-/*      INT N,I,J,K(N),IL(NMAX),IR(NMAX) */
-/* LUND */
-
-/*      DOUBLE PRECISION A(N),B(NMAX) */
-/* LUND */
-    /* Parameter adjustments */
-    --k;
-    --a;
-
-    /* Function Body */
-    if (n > 5000) {
-      // WRITE	s_stop("Sorry, not enough room in Mike's PXSORV", (ftnlen)39);
-      printf("Sorry, not enough room in Mike's PXSORV\n");
-      abort();
-    }
-    il[0] = 0;
-    ir[0] = 0;
-    i__1 = n;
-    for (i__ = 2; i__ <= i__1; ++i__) {
-	il[i__ - 1] = 0;
-	ir[i__ - 1] = 0;
-	j = 1;
-L2:
-	if (a[i__] > a[j]) {
-	    goto L5;
-	}
-	if (il[j - 1] == 0) {
-	    goto L4;
-	}
-	j = il[j - 1];
-	goto L2;
-L4:
-	ir[i__ - 1] = -j;
-	il[j - 1] = i__;
-	goto L10;
-L5:
-	if (ir[j - 1] <= 0) {
-	    goto L6;
-	}
-	j = ir[j - 1];
-	goto L2;
-L6:
-	ir[i__ - 1] = ir[j - 1];
-	ir[j - 1] = i__;
-L10:
-	;
-    }
-    i__ = 1;
-    j = 1;
-    goto L8;
-L20:
-    j = il[j - 1];
-L8:
-    if (il[j - 1] > 0) {
-	goto L20;
-    }
-L9:
-    k[i__] = j;
-    b[i__ - 1] = a[j];
-    ++i__;
-    if ((i__1 = ir[j - 1]) < 0) {
-	goto L12;
-    } else if (i__1 == 0) {
-	goto L30;
-    } else {
-	goto L13;
-    }
-L13:
-    j = ir[j - 1];
-    goto L8;
-L12:
-    j = -ir[j - 1];
-    goto L9;
-L30:
-    if ( opt == 'I') {
-	return;
-    }
-    i__1 = n;
-    for (i__ = 1; i__ <= i__1; ++i__) {
-	a[i__] = b[i__ - 1];
-    }
-    return;
-} /* pxsorv_ */
-
-/* ******************************************************************** */
-
-void pxtry_(int mode, double *cosr, int ntrak, 
-	double *pu, double *pp, double *oaxis, double *naxis, 
-	double *pnew, int *newlis, int *ok)
-{
-    /* System generated locals */
-    int i__1;
-    double d__1, d__2, d__3;
-
-    /* Builtin functions */
-
-    /* Local variables */
-    static double norm;
-    static int n, mu;
-    static double cosval;
-    static double normsq;
-    static int npp, npu;
-
-
-/* +SEQ,DECLARE. */
-/* ** Note that although PU and PP are assumed to be 2d arrays, they */
-/* ** are used as 1d in this routine for efficiency */
-/* ** Finds all particles in cone of size COSR about OAXIS direction. */
-/* ** Calculates 4-momentum sum of all particles in cone (PNEW) , and */
-/* ** returns this as new jet axis NAXIS (Both unit Vectors) */
-
-    /* Parameter adjustments */
-    --newlis;
-    --pnew;
-    --naxis;
-    --oaxis;
-    --pp;
-    --pu;
-
-    /* Function Body */
-    *ok = false;
-    for (mu = 1; mu <= 4; ++mu) {
-	pnew[mu] = (float)0.;
-    }
-    npu = -3;
-    npp = -4;
-    i__1 = ntrak;
-    for (n = 1; n <= i__1; ++n) {
-	npu += 3;
-	npp += 4;
-	if (mode != 2) {
-	    cosval = (float)0.;
-	    for (mu = 1; mu <= 3; ++mu) {
-		cosval += oaxis[mu] * pu[mu + npu];
-	    }
-	} else {
-	    if ((d__1 = pu[npu + 1], abs(d__1)) >= 20. || abs(oaxis[1]) >= 
-		    20.) {
-		cosval = -1e3;
-	    } else {
-/* Computing 2nd power */
-		d__1 = oaxis[1] - pu[npu + 1];
-		d__3 = oaxis[2] - pu[npu + 2];
-/* Computing 2nd power */
-		d__2 = pxmdpi(d__3);
-		cosval = 1 - (d__1 * d__1 + d__2 * d__2);
-	    }
-	}
-	if (cosval >= *cosr) {
-	    newlis[n] = true;
-	    *ok = true;
-	    if (mode != 2) {
-		for (mu = 1; mu <= 4; ++mu) {
-		    pnew[mu] += pp[mu + npp];
-		}
-	    } else {
-		pnew[1] += pp[npp + 4] / (pp[npp + 4] + pnew[4]) * (pp[npp + 
-			1] - pnew[1]);
-/*                PNEW(2)=PNEW(2) */
-/*     +              + PP(4+NPP)/(PP(4+NPP)+PNEW(4)) */
-/*     +               *PXMDPI(PP(2+NPP)-PNEW(2)) */
-/* GPS 25/02/07 */
-		d__2 = pp[npp + 2] - pnew[2];
-		d__1 = pnew[2] + pp[npp + 4] / (pp[npp + 4] + pnew[4]) * 
-			pxmdpi(d__2);
-		pnew[2] = pxmdpi(d__1);
-		pnew[4] += pp[npp + 4];
-	    }
-	} else {
-	    newlis[n] = false;
-	}
-    }
-/* ** If there are particles in the cone, calc new jet axis */
-    if (*ok) {
-	if (mode != 2) {
-	    normsq = (float)0.;
-	    for (mu = 1; mu <= 3; ++mu) {
-/* Computing 2nd power */
-		d__1 = pnew[mu];
-		normsq += d__1 * d__1;
-	    }
-	    norm = sqrt(normsq);
-	} else {
-	    norm = 1.;
-	}
-	for (mu = 1; mu <= 3; ++mu) {
-	    naxis[mu] = pnew[mu] / norm;
-	}
-    }
-} /* pxtry_ */
-
-
 }
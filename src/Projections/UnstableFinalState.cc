@@ -13,7 +13,6 @@ namespace Rivet {
     vetoIds += 110; vetoIds += 990; vetoIds += 9990; // Reggeons
 
     for (ConstGenParticlePtr p : HepMCUtils::particles(e.genEvent())) {
-      const Particle rp(p);
       const int st = p->status();
       bool passed =
         (st == 1 || (st == 2 && !contains(vetoIds, abs(p->pdg_id())))) &&
@@ -21,24 +20,16 @@ namespace Rivet {
         p->status() !=4 && // Filter beam particles
         _cuts->accept(p->momentum());
 
-      // Avoid double counting by re-marking as unpassed if ID == (any) parent ID
-      ConstGenVertexPtr pv = p->production_vertex();
       // Avoid double counting by re-marking as unpassed if ID == any child ID
-      ConstGenVertexPtr dv = p->end_vertex();
-      if (passed && dv) {
-        for (ConstGenParticlePtr pp : HepMCUtils::particles(dv, Relatives::CHILDREN)) {
-          if (p->pdg_id() == pp->pdg_id() && pp->status() == 2) {
-            passed = false;
-            break;
-          }
-        }
-      }
+      if (passed && !DecayGraph::lastCopy(p)) passed = false;
 
       // Add to output particles collection
-      if (passed) _theParticles.push_back(rp);
+      if (passed) _theParticles.push_back(Particle(p));
 
       // Log parents and children
       if (getLog().isActive(Log::TRACE)) {
+        ConstGenVertexPtr pv = p->production_vertex();
+        ConstGenVertexPtr dv = p->end_vertex();
         MSG_TRACE("ID = " << p->pdg_id()
                   << ", status = " << st
                   << ", pT = " << p->momentum().perp()
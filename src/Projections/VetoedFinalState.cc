@@ -44,65 +44,43 @@ namespace Rivet {
       }
     }
 
+    // Flags for particles to be removed by the composite and parent vetoes
+    vector<bool> vetoed(_theParticles.size(), false);
+
     // Composite particle mass vetoing
-    /// @todo YUCK! Clean up...
-    set<Particles::iterator> toErase;
-    for (auto nIt = _nCompositeDecays.begin(); nIt != _nCompositeDecays.end() && !_theParticles.empty(); ++nIt) {
-      map<set<Particles::iterator>, FourMomentum> oldMasses;
-      map<set<Particles::iterator>, FourMomentum> newMasses;
-      set<Particles::iterator> start;
-      start.insert(_theParticles.begin());
-      oldMasses.insert(pair<set<Particles::iterator>, FourMomentum>(start, _theParticles.begin()->momentum()));
-      for (int nParts = 1; nParts != *nIt; ++nParts) {
-        for (auto mIt = oldMasses.begin(); mIt != oldMasses.end(); ++mIt) {
-          Particles::iterator pStart = *(mIt->first.rbegin());
-          for (auto pIt = pStart + 1; pIt != _theParticles.end(); ++pIt) {
-            FourMomentum cMom = mIt->second + pIt->momentum();
-            set<Particles::iterator> pList(mIt->first);
-            pList.insert(pIt);
-            newMasses[pList] = cMom;
-          }
-        }
-        oldMasses = newMasses;
-        newMasses.clear();
+    for (int n : _nCompositeDecays) {
+      if (n < 1 || _theParticles.size() < (size_t) n) continue;
+      vector<pair<double,double> > massRanges;
+      double maxMass = -DBL_MAX;
+      for (auto cIt = _compositeVetoes.lower_bound(n); cIt != _compositeVetoes.upper_bound(n); ++cIt) {
+        massRanges.push_back(cIt->second);
+        maxMass = max(maxMass, cIt->second.second);
       }
-      for (auto mIt = oldMasses.begin(); mIt != oldMasses.end(); ++mIt) {
-        double mass2 = mIt->second.mass2();
-        if (mass2 >= 0.0) {
-          double mass = sqrt(mass2);
-          for (auto cIt = _compositeVetoes.lower_bound(*nIt); cIt != _compositeVetoes.upper_bound(*nIt); ++cIt) {
-            auto massRange = cIt->second;
-            if (mass < massRange.second && mass > massRange.first) {
-              for (auto lIt = mIt->first.begin(); lIt != mIt->first.end(); ++lIt) {
-                toErase.insert(*lIt);
-              }
-            }
-          }
-        }
-      }
-    }
-    for (auto p = toErase.rbegin(); p != toErase.rend(); ++p) {
-      _theParticles.erase(*p);
+      vector<size_t> members;
+      _vetoComposites(n, massRanges, maxMass, 0, FourMomentum(), members, vetoed);
     }
 
-
-    // Remove particles whose parents match entries in the parent veto PDG ID codes list
-    /// @todo There must be a nice way to do this -- an STL algorithm (or we provide a nicer wrapper)
-    for (PdgId vetoid : _parentVetoes) {
-      for (Particles::iterator ip = _theParticles.begin(); ip != _theParticles.end(); ++ip) {
-        ConstGenVertexPtr startVtx = ip->genParticle()->production_vertex();
-        if (startVtx == NULL) continue;
-        // Loop over parents and test their IDs
-        /// @todo Could use any() here?
-        for (ConstGenParticlePtr parent : HepMCUtils::particles(startVtx, Relatives::ANCESTORS)) {
-          if (vetoid == parent->pdg_id()) {
-            ip = _theParticles.erase(ip); --ip; //< Erase this _theParticles entry
-            break;
-          }
-        }
+    // Remove particles whose parents match entries in the parent veto PDG ID codes list,
+    // with the ancestry result of each vertex shared between all the particles below it
+    if (!_parentVetoes.empty()) {
+      map<ConstGenVertexPtr, bool> vtxvetoes;
+      for (size_t i = 0; i < _theParticles.size(); ++i) {
+        if (vetoed[i]) continue;
+        ConstGenParticlePtr gp = _theParticles[i].genParticle();
+        if (gp == nullptr) continue;
+        if (_hasVetoedAncestor(gp->production_vertex(), vtxvetoes)) vetoed[i] = true;
       }
     }
 
+    // Compact the surviving particles in a single pass
+    size_t nkeep = 0;
+    for (size_t i = 0; i < _theParticles.size(); ++i) {
+      if (vetoed[i]) continue;
+      if (nkeep != i) _theParticles[nkeep] = _theParticles[i];
+      ++nkeep;
+    }
+    _theParticles.resize(nkeep);
+
 
     // Finally veto on the registered FSes
     for (const string& ifs : _vetofsnames) {
@@ -122,4 +100,48 @@ namespace Rivet {
   }
 
 
+  void VetoedFinalState::_vetoComposites(size_t n, const vector<pair<double,double> >& massRanges, double maxMass,
+                                         size_t start, const FourMomentum& psum,
+                                         vector<size_t>& members, vector<bool>& vetoed) const {
+    for (size_t i = start; i + (n - members.size()) <= _theParticles.size(); ++i) {
+      const FourMomentum cMom = psum + _theParticles[i].momentum();
+      const double mass2 = cMom.mass2();
+      // Adding particles can't decrease the composite mass, so stop building
+      // on combinations which are already above every veto window
+      if (mass2 >= 0.0 && sqrt(mass2) >= maxMass) continue;
+      members.push_back(i);
+      if (members.size() < n) {
+        _vetoComposites(n, massRanges, maxMass, i+1, cMom, members, vetoed);
+      } else if (mass2 >= 0.0) {
+        const double mass = sqrt(mass2);
+        for (const pair<double,double>& massRange : massRanges) {
+          if (mass < massRange.second && mass > massRange.first) {
+            for (size_t m : members) vetoed[m] = true;
+            break;
+          }
+        }
+      }
+      members.pop_back();
+    }
+  }
+
+
+  bool VetoedFinalState::_hasVetoedAncestor(ConstGenVertexPtr vtx, map<ConstGenVertexPtr, bool>& vtxvetoes) const {
+    if (vtx == nullptr) return false;
+    const auto iv = vtxvetoes.find(vtx);
+    if (iv != vtxvetoes.end()) return iv->second;
+    vtxvetoes[vtx] = false; //< guard against loops in malformed event graphs
+    bool rtn = false;
+    for (ConstGenParticlePtr parent : HepMCUtils::particles(vtx, Relatives::PARENTS)) {
+      if (_parentVetoes.find(parent->pdg_id()) != _parentVetoes.end() ||
+          _hasVetoedAncestor(parent->production_vertex(), vtxvetoes)) {
+        rtn = true;
+        break;
+      }
+    }
+    vtxvetoes[vtx] = rtn;
+    return rtn;
+  }
+
+
 }
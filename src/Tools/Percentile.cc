@@ -10,11 +10,208 @@ void PercentileBase::selectBins(const Event & ev) {
   const CentralityProjection & proj =
     _ana->apply<CentralityProjection>(ev, _projName);
   _activeBins.clear();
+  double pcnt = proj();
+  if ( !proj.empty() && !proj.calibrated() ) {
+    // No calibration available: journal the raw estimator value until
+    // the end of the run, after which the derived calibration is used.
+    pcnt = proj.raw();
+    if ( !_journal ) {
+      _journal = make_shared<PercentileJournal>(_cent, proj.increasing());
+      _journal->restore(_ana->_getJournalPreload(_ana->_journals.size()));
+      _ana->_journals.push_back(_journal);
+    }
+    if ( _journal->recording() ) {
+      _journal->beginEvent(ev, pcnt);
+      return;
+    }
+    pcnt = _journal->percentile(pcnt);
+  }
   const int nCent = _cent.size();
   for (int iCent = 0; iCent < nCent; ++iCent) {
-    if ( inRange(proj(), _cent[iCent]) )
+    if ( inRange(pcnt, _cent[iCent]) )
       _activeBins.push_back(iCent);
   }
 }
 
+
+namespace {
+
+  // Record tags in the journal spill file.
+  const char EVENT_TAG = 'E';
+  const char FILL_TAG = 'F';
+
+  template <typename T>
+  void _write(FILE * f, const T * x, size_t n = 1) {
+    if ( n > 0 && fwrite(x, sizeof(T), n, f) != n )
+      throw Error("Could not write to the centrality journal spill file");
+  }
+
+  template <typename T>
+  void _read(FILE * f, T * x, size_t n = 1) {
+    if ( n > 0 && fread(x, sizeof(T), n, f) != n )
+      throw Error("Corrupt centrality journal spill file");
+  }
+
+  /// One record read back from the journal.
+  struct JournalRecord {
+    char tag;
+    int64_t evtnum;
+    double est;
+    valarray<double> weights;
+    vector<double> args;
+  };
+
+  bool _readRecord(FILE * f, JournalRecord & r) {
+    if ( fread(&r.tag, 1, 1, f) != 1 ) return false;
+    uint32_t n = 0;
+    if ( r.tag == EVENT_TAG ) {
+      _read(f, &r.evtnum);
+      _read(f, &r.est);
+      _read(f, &n);
+      r.weights.resize(n);
+      if ( n > 0 ) _read(f, &r.weights[0], n);
+    } else if ( r.tag == FILL_TAG ) {
+      _read(f, &n);
+      r.args.resize(n);
+      _read(f, r.args.data(), n);
+    } else {
+      throw Error("Corrupt centrality journal spill file");
+    }
+    return true;
+  }
+
+}
+
+
+void PercentileJournal::_open() {
+  if ( _file ) return;
+  _file = tmpfile();
+  if ( !_file ) throw Error("Could not open a spill file for the centrality journal");
+}
+
+
+void PercentileJournal::beginEvent(int64_t evtnum, const valarray<double> & weights, double est) {
+  _open();
+  const uint32_t nw = weights.size();
+  _write(_file, &EVENT_TAG);
+  _write(_file, &evtnum);
+  _write(_file, &est);
+  _write(_file, &nw);
+  if ( nw > 0 ) _write(_file, &weights[0], nw);
+}
+
+
+void PercentileJournal::addFill(const double * args, size_t nargs) {
+  // Fills before the first init() cannot be assigned to any event.
+  if ( !_file ) return;
+  const uint32_t n = nargs;
+  _write(_file, &FILL_TAG);
+  _write(_file, &n);
+  _write(_file, args, nargs);
+}
+
+
+void PercentileJournal::replay(size_t nominal) {
+  if ( !_recording ) return;
+  _recording = false;
+  if ( !_file ) return;
+  if ( fflush(_file) != 0 ) throw Error("Could not write to the centrality journal spill file");
+
+  // First pass: the estimator distribution with the nominal weights.
+  rewind(_file);
+  JournalRecord r;
+  vector<pair<double, double> > dist;
+  while ( _readRecord(_file, r) )
+    if ( r.tag == EVENT_TAG )
+      dist.push_back(make_pair(r.est, nominal < r.weights.size() ? r.weights[nominal] : 1.0));
+  sort(dist.begin(), dist.end());
+
+  // Merge equal values and build the percentile table, assigning each
+  // value the middle of its own weight, as for a histogram bin.
+  vector<pair<double, double> > vals;
+  double sumw = 0.0;
+  for ( const auto & d : dist ) {
+    sumw += d.second;
+    if ( !vals.empty() && vals.back().first == d.first ) vals.back().second += d.second;
+    else vals.push_back(d);
+  }
+  dist.clear();
+  _table.clear();
+  if ( sumw > 0.0 ) {
+    // Keep at most 10000 points in the interpolation table.
+    const size_t step = max<size_t>(1, vals.size()/10000);
+    double acc = 0.0;
+    for ( size_t i = 0, N = vals.size(); i < N; ++i ) {
+      const double w = vals[i].second;
+      const double below = acc + 0.5*w;
+      acc += w;
+      if ( i%step != 0 && i + 1 != N ) continue;
+      _table[vals[i].first] = 100.0*(_increasing? below: sumw - below)/sumw;
+    }
+  }
+
+  // Second pass: replay the events into the selected bins, grouping
+  // sub-events with the same event number.
+  rewind(_file);
+  vector<valarray<double> > groupw;
+  int64_t groupnum = 0;
+  vector<int> active;
+  auto push = [&]() {
+    if ( groupw.empty() ) return;
+    for ( const auto & ao : _aos ) ao.get()->pushToPersistent(groupw);
+    groupw.clear();
+  };
+  while ( _readRecord(_file, r) ) {
+    if ( r.tag == EVENT_TAG ) {
+      if ( !groupw.empty() && r.evtnum != groupnum ) push();
+      groupnum = r.evtnum;
+      groupw.push_back(r.weights);
+      for ( const auto & ao : _aos ) ao.get()->newSubEvent();
+      active.clear();
+      const double pcnt = percentile(r.est);
+      for ( int i = 0, N = _cent.size(); i < N; ++i )
+        if ( PercentileBase::inRange(pcnt, _cent[i]) ) active.push_back(i);
+      if ( _count ) _count(active);
+    } else if ( hasReplayer(r.args.size()) && !groupw.empty() ) {
+      _replayers[r.args.size()](active, r.args.data());
+    }
+  }
+  push();
+
+  fclose(_file);
+  _file = nullptr;
+}
+
+
+string PercentileJournal::spill() const {
+  if ( !_recording || !_file ) return "";
+  if ( fflush(_file) != 0 ) throw Error("Could not write to the centrality journal spill file");
+  const long size = ftell(_file);
+  if ( size < 0 ) throw Error("Could not read the centrality journal spill file");
+  string data(size, '\0');
+  rewind(_file);
+  _read(_file, &data[0], data.size());
+  fseek(_file, 0, SEEK_END);
+  return data;
+}
+
+
+void PercentileJournal::restore(const string & data) {
+  if ( data.empty() ) return;
+  _open();
+  _write(_file, data.data(), data.size());
+}
+
+
+double PercentileJournal::percentile(double est) const {
+  if ( _table.empty() ) return -1.0;
+  auto high = _table.upper_bound(est);
+  if ( high == _table.begin() ) return _increasing? 0.0: 100.0;
+  auto low = prev(high);
+  if ( high == _table.end() )
+    return low->first == est? low->second: (_increasing? 100.0: 0.0);
+  return low->second + (est - low->first)*(high->second - low->second)/
+    (high->first - low->first);
+}
+
 }
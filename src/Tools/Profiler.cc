@@ -0,0 +1,170 @@
+// -*- C++ -*-
+#include "Rivet/Tools/Profiler.hh"
+#include "Rivet/Projection.hh"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+namespace Rivet {
+
+
+  namespace {
+
+    /// Records ordered by decreasing total time
+    vector<const Profiler::Record*> _byTime(const vector<const Profiler::Record*>& recs) {
+      vector<const Profiler::Record*> rtn = recs;
+      std::stable_sort(rtn.begin(), rtn.end(),
+                       [](const Profiler::Record* a, const Profiler::Record* b) { return a->seconds > b->seconds; });
+      return rtn;
+    }
+
+    /// Escape a string for inclusion in JSON output
+    string _jsonString(const string& s) {
+      string rtn = "\"";
+      for (char c : s) {
+        if (c == '"' || c == '\\') rtn += '\\';
+        rtn += c;
+      }
+      return rtn + "\"";
+    }
+
+    void _writeJSONRecord(std::ostream& os, const Profiler::Record& r) {
+      os << "{\"name\": " << _jsonString(r.name)
+         << ", \"calls\": " << r.calls
+         << ", \"hits\": " << r.hits
+         << ", \"fills\": " << r.fills
+         << ", \"seconds\": " << r.seconds
+         << ", \"users\": [";
+      bool first = true;
+      for (const string& u : r.users) {
+        os << (first ? "" : ", ") << _jsonString(u);
+        first = false;
+      }
+      os << "]}";
+    }
+
+  }
+
+
+  Profiler& Profiler::global() {
+    static Profiler prof;
+    return prof;
+  }
+
+
+  void Profiler::reset() {
+    _analyses.clear();
+    _projections.clear();
+    _push = Record();
+    _push.name = "AnalysisHandler::pushToPersistent";
+  }
+
+
+  void Profiler::analysisCall(const string& ananame, double t0) {
+    Record& r = _analyses[ananame];
+    r.name = ananame;
+    r.calls += 1;
+    r.seconds += clock() - t0;
+  }
+
+
+  void Profiler::analysisFills(const string& ananame, size_t nfills) {
+    Record& r = _analyses[ananame];
+    r.name = ananame;
+    r.fills += nfills;
+  }
+
+
+  Profiler::Record& Profiler::_projRecord(const Projection& p) {
+    Record& r = _projections[&p];
+    if (r.name.empty()) r.name = p.name();
+    if (!_current.empty()) r.users.insert(_current);
+    return r;
+  }
+
+
+  void Profiler::projectionCall(const Projection& p, double t0) {
+    const double dt = clock() - t0;
+    Record& r = _projRecord(p);
+    r.calls += 1;
+    r.seconds += dt;
+  }
+
+
+  void Profiler::projectionHit(const Projection& p) {
+    _projRecord(p).hits += 1;
+  }
+
+
+  void Profiler::pushCall(double t0) {
+    _push.calls += 1;
+    _push.seconds += clock() - t0;
+  }
+
+
+  void Profiler::writeText(std::ostream& os) const {
+    vector<const Record*> anas, projs;
+    for (const auto& ar : _analyses) anas.push_back(&ar.second);
+    for (const auto& pr : _projections) projs.push_back(&pr.second);
+
+    os << "Analyses (analyze calls, inclusive of projections they triggered first):\n";
+    os << std::setw(12) << "time/s" << std::setw(12) << "calls"
+       << std::setw(14) << "fills" << "  name\n";
+    for (const Record* r : _byTime(anas)) {
+      os << std::setw(12) << std::fixed << std::setprecision(3) << r->seconds
+         << std::setw(12) << r->calls << std::setw(14) << r->fills << "  " << r->name << "\n";
+    }
+
+    os << "\nProjections (inclusive of sub-projections):\n";
+    os << std::setw(12) << "time/s" << std::setw(12) << "calls"
+       << std::setw(12) << "hits" << std::setw(8) << "hit%" << "  name [users]\n";
+    for (const Record* r : _byTime(projs)) {
+      const size_t nreq = r->calls + r->hits;
+      os << std::setw(12) << std::fixed << std::setprecision(3) << r->seconds
+         << std::setw(12) << r->calls << std::setw(12) << r->hits
+         << std::setw(8) << std::setprecision(1) << (nreq > 0 ? 100.0*r->hits/nreq : 0.0)
+         << "  " << r->name << " [";
+      bool first = true;
+      for (const string& u : r->users) {
+        os << (first ? "" : ", ") << u;
+        first = false;
+      }
+      os << "]\n";
+    }
+
+    os << "\n" << _push.name << ": " << std::setprecision(3) << _push.seconds
+       << " s in " << _push.calls << " calls\n";
+    os.unsetf(std::ios_base::floatfield);
+  }
+
+
+  void Profiler::writeJSON(std::ostream& os) const {
+    os << "{\n  \"analyses\": [";
+    bool first = true;
+    for (const auto& ar : _analyses) {
+      os << (first ? "\n    " : ",\n    ");
+      _writeJSONRecord(os, ar.second);
+      first = false;
+    }
+    os << "\n  ],\n  \"projections\": [";
+    first = true;
+    for (const auto& pr : _projections) {
+      os << (first ? "\n    " : ",\n    ");
+      _writeJSONRecord(os, pr.second);
+      first = false;
+    }
+    os << "\n  ],\n  \"push\": ";
+    _writeJSONRecord(os, _push);
+    os << "\n}\n";
+  }
+
+
+  void Profiler::writeReports(const string& basename) const {
+    std::ofstream txt(basename + ".txt");
+    writeText(txt);
+    std::ofstream json(basename + ".json");
+    writeJSON(json);
+  }
+
+
+}
@@ -14,6 +14,8 @@
 #include "HepMC3/GenVertex.h"
 #include "HepMC3/Units.h"
 #include <cstring>
+#include <cstdlib>
+#include <cctype>
 #include <sstream>
 
 namespace Rivet {
@@ -21,8 +23,46 @@ namespace Rivet {
 using namespace HepMC3;
 
 
+namespace {
+
+  /// Read an integer at @a s, advancing it past the number
+  bool readLong(const char*& s, long& x) {
+    char* end = nullptr;
+    x = strtol(s, &end, 10);
+    if ( end == s ) return false;
+    s = end;
+    return true;
+  }
+
+  bool readInt(const char*& s, int& x) {
+    long l = 0;
+    if ( !readLong(s, l) ) return false;
+    x = int(l);
+    return true;
+  }
+
+  /// Read a floating point number at @a s, advancing it past the number
+  bool readDouble(const char*& s, double& x) {
+    char* end = nullptr;
+    x = strtod(s, &end);
+    if ( end == s ) return false;
+    s = end;
+    return true;
+  }
+
+  /// Skip white space and consume the character @a c if it is next
+  bool readChar(const char*& s, char c) {
+    while ( isspace((unsigned char)*s) ) ++s;
+    if ( *s != c ) return false;
+    ++s;
+    return true;
+  }
+
+}
+
+
 ReaderCompressedAscii::ReaderCompressedAscii(const string &filename)
-  : m_file(filename), m_stream(0), m_evt(0), m_precision_phi(0.001),
+  : m_file(filename), m_stream(0), m_cur(0), m_evt(0), m_precision_phi(0.001),
     m_precision_eta(0.001), m_precision_e(0.001), m_precision_m(0.000001),
     m_using_integers(false) {
   if( !m_file.is_open() ) {
@@ -35,7 +75,7 @@ ReaderCompressedAscii::ReaderCompressedAscii(const string &filename)
 
 // Ctor for reading from stdin
 ReaderCompressedAscii::ReaderCompressedAscii(std::istream & stream)
-  : m_stream(&stream), m_evt(0), m_precision_phi(0.001),
+  : m_stream(&stream), m_cur(0), m_evt(0), m_precision_phi(0.001),
     m_precision_eta(0.001), m_precision_e(0.001), m_precision_m(0.000001),
     m_using_integers(false) {
   if( !m_stream ) {
@@ -63,20 +103,30 @@ bool ReaderCompressedAscii::read_event(GenEvent &evt) {
   evt.clear();
   evt.set_run_info(run_info());
   m_masses.clear();
-  m_vertices.clear();
-  m_particles.clear();
+  m_data = GenEventData();
+  m_data.momentum_unit = evt.momentum_unit();
+  m_data.length_unit = evt.length_unit();
+  m_data.event_pos = FourVector::ZERO_VECTOR();
   m_ppvx.clear();
+  m_vkeys.clear();
+  m_vdata.clear();
   m_vpin.clear();
+  m_vpinbegin.clear();
   //
   // Parse event, vertex and particle information
   //
   while(!failed()) {
 
     std::getline(*m_stream, line);
-    is.clear();
-    is.str(line);
-is.get(); // Remove the first character from the stream.
     if ( line.empty() ) continue;
+    // Vertex and particle lines are decoded straight from the line
+    // buffer, the rest through the string stream.
+    m_cur = line.c_str() + 1;
+    if ( line[0] != 'P' && line[0] != 'V' ) {
+      is.clear();
+      is.str(line);
+      is.get(); // Remove the first character from the stream.
+    }
 
     if ( line.substr(0, 5) == "HepMC" ) {
       if ( line.substr(0, 14) != "HepMC::Version" &&
@@ -136,18 +186,7 @@ is.get(); // Remove the first character from the stream.
          ( m_stream->peek() == 'E' || m_stream->peek() == 'H') )break;
   }
 
-    // Set the production vertex for all particles.
-    for ( int ip = 0, Np = m_particles.size(); ip < Np; ++ip )
-      if ( m_ppvx[ip] && m_vertices[m_ppvx[ip]] )
-        m_vertices[m_ppvx[ip]]->add_particle_out(m_particles[ip]);
-
-    // Add the incoming particles to all vertices
-    for ( auto iv : m_vertices )
-      for ( auto ip : m_vpin[iv.first] ) iv.second->add_particle_in(m_particles[ip - 1]);
-
-    // When all particles and vertices are connected we add all of them to the event.
-    for ( auto p : m_particles ) evt.add_particle(p);
-    for ( auto v : m_vertices ) evt.add_vertex(v.second);
+  build_event(evt);
 
   // Check if all particles and vertices were parsed
   if ((int)m_evt->particles().size() > vertices_and_particles.second ) {
@@ -191,16 +230,16 @@ pair<int,int> ReaderCompressedAscii::parse_event_information() {
   int                         event_no = 0;
 
   // event number
-  if ( !(is >> event_no) ) return err;
-  m_evt->set_event_number(event_no);
+  if ( !readInt(m_cur, event_no) ) return err;
+  m_data.event_number = event_no;
 
   // num_vertices
-  if ( !(is>> ret.first) ) return err;
+  if ( !readInt(m_cur, ret.first) ) return err;
 
   // num_particles
-  if ( !(is>> ret.second) ) return err;
+  if ( !readInt(m_cur, ret.second) ) return err;
 
-  if ( !read_position() ) return err;
+  if ( !read_position(m_data.event_pos) ) return err;
 
   DEBUG( 10, "ReaderCompressedAscii: E: "<<event_no<<" ("<<ret.first<<"V, "<<ret.second<<"P)" )
 
@@ -223,7 +262,7 @@ bool ReaderCompressedAscii::parse_weight_values() {
       + std::to_string((long long int)(run_info()->weight_names().size()))+
       ") in the GenRunInfo object");
 
-  m_evt->weights() = wts;
+  m_data.weights = wts;
 
   return true;
 }
@@ -237,54 +276,53 @@ bool ReaderCompressedAscii::parse_precision() {
 }
 
 bool ReaderCompressedAscii::parse_vertex_information() {
-  GenVertexPtr  data = make_shared<GenVertex>();
+  GenVertexData data;
+  data.position = FourVector::ZERO_VECTOR();
 
   int id = 0;
-  if ( !(is >> id) ) return false;
+  if ( !readInt(m_cur, id) ) return false;
 
-  int status = 0;
-  if  ( !(is >> status) ) return false;
-  data->set_status( status );
+  if ( !readInt(m_cur, data.status) ) return false;
 
-  std::string incoming;
-  if ( !(is >> incoming) ) return false;
-  std::string::size_type i = std::string::npos;
-  while ( ( i = incoming.find_first_of("[,]") ) != std::string::npos )
-    incoming[i] = ' ';
-  std::istringstream isin(incoming);
-  int pin = 0;
-  vector<int> vpin;
-  while ( isin >> pin ) vpin.push_back(pin);
+  // The incoming particles, as [i,j,...] or just ] if there are none.
+  while ( isspace((unsigned char)*m_cur) ) ++m_cur;
+  if ( !*m_cur ) return false;
+  m_vpinbegin.push_back(m_vpin.size());
+  while ( *m_cur && !isspace((unsigned char)*m_cur) ) {
+    if ( *m_cur == '[' || *m_cur == ',' || *m_cur == ']' ) {
+      ++m_cur;
+      continue;
+    }
+    int pin = 0;
+    if ( !readInt(m_cur, pin) ) return false;
+    m_vpin.push_back(pin);
+  }
 
-  if ( !read_position(data) ) return false;
+  if ( !read_position(data.position) ) return false;
 
-  m_vertices[-id] = data;
-  m_vpin[-id] = vpin;
+  m_vkeys.push_back(-id);
+  m_vdata.push_back(data);
 
   return true;
 }
 
 
 bool ReaderCompressedAscii::parse_particle_information() {
-  GenParticlePtr  data = make_shared<GenParticle>();
+  GenParticleData data;
 
   int id = 0;
-  if ( !(is >> id) ) return false;
+  if ( !readInt(m_cur, id) ) return false;
 
   int ivp = 0;
-  if ( !(is >> ivp) ) return false;
+  if ( !readInt(m_cur, ivp) ) return false;
 
-  int pdgid = 0;
-  if ( !(is >> pdgid) ) return false;
-  data->set_pid(pdgid);
+  if ( !readInt(m_cur, data.pid) ) return false;
 
   if ( !read_momentum(data) ) return false;
 
-  int status = 0;
-  if ( !(is >> status) ) return false;
-  data->set_status(status);
+  if ( !readInt(m_cur, data.status) ) return false;
 
-  m_particles.push_back(data);
+  m_data.particles.push_back(data);
   m_ppvx.push_back(-ivp);
 
   return true;
@@ -300,10 +338,9 @@ bool ReaderCompressedAscii::parse_attribute() {
   is.get();
   string contents;
   if ( !std::getline(is, contents) ) return false;
-  shared_ptr<Attribute> att =
-    make_shared<StringAttribute>(StringAttribute(unescape(contents)));
-
-  m_evt->add_attribute(name, att, id);
+  m_data.attribute_id.push_back(id);
+  m_data.attribute_name.push_back(name);
+  m_data.attribute_string.push_back(unescape(contents));
 
   return true;
 }
@@ -359,17 +396,17 @@ bool ReaderCompressedAscii::parse_tool() {
 
 }
 
-bool ReaderCompressedAscii::read_position(GenVertexPtr v) {
-  string at;
-  if ( !(is >> at) ) return true;
-  if ( at != "@" ) return false;
+bool ReaderCompressedAscii::read_position(FourVector& pos) {
+  while ( isspace((unsigned char)*m_cur) ) ++m_cur;
+  if ( !*m_cur ) return true;
+  if ( !readChar(m_cur, '@') ) return false;
 
   if ( !m_using_integers ) {
     double x = 0.0, y = 0.0, z = 0.0, t = 0.0;
-    if ( !(is >> x >> y >> z >> t) ) return false;
-    FourVector pos(x, y, z, t);
-    Units::convert(pos, Units::MM, m_evt->length_unit());
-    v->set_position(pos);
+    if ( !readDouble(m_cur, x) || !readDouble(m_cur, y) ||
+         !readDouble(m_cur, z) || !readDouble(m_cur, t) ) return false;
+    pos = FourVector(x, y, z, t);
+    Units::convert(pos, Units::MM, m_data.length_unit);
     return true;
   }
 
@@ -377,46 +414,51 @@ bool ReaderCompressedAscii::read_position(GenVertexPtr v) {
   long iphi = 0;
   double p3mod = 0.0;
   double t = 0.0;
-  if ( !(is >> ieta >> iphi >> p3mod >> t) ) return false;
+  if ( !readLong(m_cur, ieta) || !readLong(m_cur, iphi) ||
+       !readDouble(m_cur, p3mod) || !readDouble(m_cur, t) ) return false;
 
   double eta = double(ieta)*m_precision_eta;
   double phi = double(iphi)*m_precision_phi*M_PI;
   double pt = p3mod/cosh(eta);
-  FourVector pos(pt*cos(phi), pt*sin(phi), p3mod*tanh(eta), t);
+  pos = FourVector(pt*cos(phi), pt*sin(phi), p3mod*tanh(eta), t);
 
-  Units::convert(pos, Units::MM, m_evt->length_unit());
-  v->set_position(pos);
+  Units::convert(pos, Units::MM, m_data.length_unit);
 
   return true;
 
 }
 
-bool ReaderCompressedAscii::read_momentum(GenParticlePtr p) {
+bool ReaderCompressedAscii::read_momentum(GenParticleData& p) {
+  p.is_mass_set = true;
   if ( !m_using_integers ) {
     double px = 0.0, py = 0.0, pz = 0.0, e = 0.0, m = 0.0;
-    if ( !(is >> px >> py >> pz >> e >> m) ) return false;
+    if ( !readDouble(m_cur, px) || !readDouble(m_cur, py) ||
+         !readDouble(m_cur, pz) || !readDouble(m_cur, e) ||
+         !readDouble(m_cur, m) ) return false;
     FourVector pp(px, py, pz, e);
   
-    if ( m_evt->momentum_unit() != Units::GEV ) {
+    if ( m_data.momentum_unit != Units::GEV ) {
       m *= 1000.0;
-      Units::convert(pp, Units::GEV, m_evt->momentum_unit());
+      Units::convert(pp, Units::GEV, m_data.momentum_unit);
     }
-    p->set_momentum(pp);
-    p->set_generated_mass(m);
+    p.momentum = pp;
+    p.mass = m;
     return true;
   }
     
   long iphi = 0;
   long ieta = 0;
   double ie = 0;
-  std::string sm;
-  if ( !(is >> ie >> ieta >> iphi >> sm) ) return false;
+  if ( !readDouble(m_cur, ie) || !readLong(m_cur, ieta) ||
+       !readLong(m_cur, iphi) ) return false;
 
   double m = 0.0;
-  if ( sm == "*" ) {
-    m = m_masses[p->pid()]*m_precision_m;
+  if ( readChar(m_cur, '*') ) {
+    m = m_masses[p.pid]*m_precision_m;
   } else {
-    m = (m_masses[p->pid()] = stol(sm))*m_precision_m;
+    long im = 0;
+    if ( !readLong(m_cur, im) ) return false;
+    m = (m_masses[p.pid] = im)*m_precision_m;
   }
 
   double e = double(ie)*m_precision_e;
@@ -427,17 +469,61 @@ bool ReaderCompressedAscii::read_momentum(GenParticlePtr p) {
   double pt = abs(eta) < 100.0? p3mod/cosh(eta): 0.0;
   FourVector pp(pt*cos(phi), pt*sin(phi), p3mod*tanh(eta), e);
   
-  if ( m_evt->momentum_unit() != Units::GEV ) {
+  if ( m_data.momentum_unit != Units::GEV ) {
     m *= 1000.0;
-    Units::convert(pp, Units::GEV, m_evt->momentum_unit());
+    Units::convert(pp, Units::GEV, m_data.momentum_unit);
   }
 
-  p->set_momentum(pp);
-  p->set_generated_mass(m);
+  p.momentum = pp;
+  p.mass = m;
 
   return true;
 }
 
+void ReaderCompressedAscii::build_event(GenEvent& evt) {
+
+  // Vertices are numbered in order of their ids in the file. A later
+  // vertex with the same id replaces an earlier one.
+  const size_t Nv = m_vkeys.size(), Np = m_data.particles.size();
+  int maxkey = 0;
+  for ( int key : m_vkeys ) maxkey = max(maxkey, key);
+  vector<int> bykey(maxkey + 1, -1);
+  for ( size_t iv = 0; iv < Nv; ++iv )
+    if ( m_vkeys[iv] >= 0 ) bykey[m_vkeys[iv]] = iv;
+  vector<int> newid(Nv, 0);
+  m_data.vertices.reserve(Nv);
+  for ( int key = 0; key <= maxkey; ++key ) {
+    if ( bykey[key] < 0 ) continue;
+    m_data.vertices.push_back(m_vdata[bykey[key]]);
+    newid[bykey[key]] = -int(m_data.vertices.size());
+  }
+  m_vpinbegin.push_back(m_vpin.size());
+
+  // First the production vertex of every particle, then the incoming
+  // particles of every vertex.
+  m_data.links1.reserve(Np + m_vpin.size());
+  m_data.links2.reserve(Np + m_vpin.size());
+  for ( size_t ip = 0; ip < Np; ++ip ) {
+    const int key = m_ppvx[ip];
+    if ( key <= 0 || key > maxkey || bykey[key] < 0 ) continue;
+    m_data.links1.push_back(newid[bykey[key]]);
+    m_data.links2.push_back(ip + 1);
+  }
+  for ( int key = 0; key <= maxkey; ++key ) {
+    const int iv = bykey[key];
+    if ( iv < 0 ) continue;
+    for ( size_t i = m_vpinbegin[iv]; i < m_vpinbegin[iv + 1]; ++i ) {
+      if ( m_vpin[i] <= 0 || m_vpin[i] > int(Np) ) continue;
+      m_data.links1.push_back(m_vpin[i]);
+      m_data.links2.push_back(newid[iv]);
+    }
+  }
+
+  evt.read_data(m_data);
+  evt.set_run_info(run_info());
+
+}
+
 string ReaderCompressedAscii::unescape(const string& s) {
   string ret;
   ret.reserve(s.length());
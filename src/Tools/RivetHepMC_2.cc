@@ -108,6 +108,10 @@ namespace Rivet{
     int uniqueId(ConstGenParticlePtr gp){
       return gp->barcode();
     }
+
+    int uniqueId(ConstGenVertexPtr gv){
+      return gv->barcode();
+    }
     
     int particles_size(ConstGenEventPtr ge){
       return ge->particles_size();
@@ -6,6 +6,7 @@
 #include "HepMC3/ReaderAsciiHepMC2.h"
 #include "HepMC3/GenCrossSection.h"
 #include "HepMC3/ReaderFactory.h"
+#include "HepMC3/Data/GenEventData.h"
 #include <cassert>
 #include "../Core/zstr/zstr.hpp"
 
@@ -54,6 +55,10 @@ namespace Rivet{
     int uniqueId(ConstGenParticlePtr gp){
       return gp->id();
     }
+
+    int uniqueId(ConstGenVertexPtr gv){
+      return gv->id();
+    }
     
     std::pair<ConstGenParticlePtr,ConstGenParticlePtr> beams(const GenEvent *ge) {
       std::vector<ConstGenParticlePtr> beamlist = ge->beams();
@@ -135,49 +140,205 @@ namespace Rivet{
       return ret;
     }
 
+    namespace {
+
+      /// @brief Flat copy of an event graph for stripping
+      ///
+      /// Particles and vertices are indices into the GenEventData arrays.
+      /// Each particle sits in at most one outgoing and one incoming list,
+      /// so the per-vertex lists are intrusive doubly-linked lists, with
+      /// O(1) removal and splicing in the same order as HepMC3's vectors.
+      /// Merged vertices are tracked by union-find rather than by
+      /// re-pointing every particle.
+      struct StripGraph {
+
+        struct List {
+          int head = -1, tail = -1;
+          size_t size = 0;
+        };
+
+        explicit StripGraph(const HepMC3::GenEventData & data)
+          : np(data.particles.size()), nv(data.vertices.size()),
+            prodv(np, -1), endv(np, -1),
+            nextout(np, -1), prevout(np, -1), nextin(np, -1), previn(np, -1),
+            outs(nv), ins(nv), parent(nv), removedp(np, false)
+        {
+          for ( size_t v = 0; v < nv; ++v ) parent[v] = v;
+          // Links come in vertex order, with each vertex's incoming
+          // particles before its outgoing ones, in HepMC3's list order
+          for ( size_t i = 0; i < data.links1.size(); ++i ) {
+            const int id1 = data.links1[i], id2 = data.links2[i];
+            if ( id1 > 0 && id2 < 0 ) {
+              endv[id1-1] = -id2-1;
+              pushIn(-id2-1, id1-1);
+            } else if ( id1 < 0 && id2 > 0 ) {
+              prodv[id2-1] = -id1-1;
+              pushOut(-id1-1, id2-1);
+            }
+          }
+        }
+
+        /// Current (merged) vertex of a raw vertex index
+        int find(int v) {
+          if ( v < 0 ) return v;
+          while ( parent[v] != v ) {
+            parent[v] = parent[parent[v]];
+            v = parent[v];
+          }
+          return v;
+        }
+
+        void pushOut(int v, int p) { _push(outs[v], nextout, prevout, p); }
+        void pushIn(int v, int p) { _push(ins[v], nextin, previn, p); }
+        void unlinkOut(int v, int p) { _unlink(outs[v], nextout, prevout, p); }
+        void unlinkIn(int v, int p) { _unlink(ins[v], nextin, previn, p); }
+
+        /// Append the list @a from to the end of @a to, leaving @a from empty
+        static void splice(List & to, List & from, vector<int> & next, vector<int> & prev) {
+          if ( from.size == 0 ) return;
+          if ( to.size == 0 ) {
+            to = from;
+          } else {
+            next[to.tail] = from.head;
+            prev[from.head] = to.tail;
+            to.tail = from.tail;
+            to.size += from.size;
+          }
+          from = List();
+        }
+
+        size_t np, nv;
+        vector<int> prodv, endv;
+        vector<int> nextout, prevout, nextin, previn;
+        vector<List> outs, ins;
+        vector<int> parent;
+        vector<bool> removedp;
+
+      private:
+
+        static void _push(List & l, vector<int> & next, vector<int> & prev, int p) {
+          prev[p] = l.tail;
+          next[p] = -1;
+          if ( l.tail >= 0 ) next[l.tail] = p;
+          else l.head = p;
+          l.tail = p;
+          ++l.size;
+        }
+
+        static void _unlink(List & l, vector<int> & next, vector<int> & prev, int p) {
+          if ( prev[p] >= 0 ) next[prev[p]] = next[p];
+          else l.head = next[p];
+          if ( next[p] >= 0 ) prev[next[p]] = prev[p];
+          else l.tail = prev[p];
+          next[p] = prev[p] = -1;
+          --l.size;
+        }
+
+      };
+
+    }
+
+
     void strip(GenEvent & ge, const set<long> & stripid) {
-      //      std::cerr << "Stripping event " << ge.event_number() << std::endl;
-      vector<HepMC3::GenParticlePtr> allparticles = ge.particles();
-      for ( auto & p : allparticles ) {
-        if ( !p->production_vertex() || !p->end_vertex() ||
-             stripid.count(p->pid()) == 0 ||
-             p->production_vertex()->id() == 0  ) continue;
-        // std::cout << "Removing particle " << p->id()
-        //           << " (" << p->pid() << ")" << std::endl;
-        HepMC3::GenVertexPtr vp = p->production_vertex();
-        HepMC3::GenVertexPtr ve = p->end_vertex();
-        if ( !vp || !ve ) continue;
+      // The event is flattened, stripped as a plain index graph and then
+      // rebuilt once. The decisions and the resulting topology are the
+      // same as removing the particles one by one from the GenEvent, which
+      // is quadratic since every removal renumbers the whole event.
+      HepMC3::GenEventData data;
+      ge.write_data(data);
+      StripGraph g(data);
+      const size_t np = g.np, nv = g.nv;
+
+      vector<size_t> stamp(np, 0);
+      size_t nstamp = 0;
+      size_t nremoved = 0;
+      for ( size_t ip = 0; ip < np; ++ip ) {
+        const int p = ip;
+        // Particles from the root vertex have no production vertex here
+        if ( g.prodv[p] < 0 || g.endv[p] < 0 ||
+             stripid.count(data.particles[p].pid) == 0 ) continue;
+        const int vp = g.find(g.prodv[p]);
+        const int ve = g.find(g.endv[p]);
         if ( vp == ve ) continue;
-        // Check if the vertices would leave particles with the sam
+        // Check if the vertices would leave particles with the same
         // production as decay vertex - we don't want that.
-        if ( ( vp->particles_out().size() == 1 && vp->particles_out()[0] == p ) ||
-             ( ve->particles_in().size() == 1 && ve->particles_in()[0] == p ) ) {
+        if ( ( g.outs[vp].size == 1 && g.outs[vp].head == p ) ||
+             ( g.ins[ve].size == 1 && g.ins[ve].head == p ) ) {
+          ++nstamp;
+          for ( int pi = g.ins[vp].head; pi >= 0; pi = g.nextin[pi] ) stamp[pi] = nstamp;
           bool loop = false;
-          for ( auto pi : vp->particles_in() )
-            for ( auto po : ve->particles_out() )
-              if ( pi == po ) loop = true;
+          for ( int po = g.outs[ve].head; po >= 0 && !loop; po = g.nextout[po] )
+            loop = stamp[po] == nstamp;
           if ( loop ) continue;
         }
-        if ( vp->particles_in().size() == 1 &&
-             ( vp->particles_in()[0]->pid() > 21 &&
-               vp->particles_in()[0]->pid() < 30 ) )
+        if ( g.ins[vp].size == 1 &&
+             ( data.particles[g.ins[vp].head].pid > 21 &&
+               data.particles[g.ins[vp].head].pid < 30 ) )
           continue;
-    
-        vp->remove_particle_out(p);
-        ve->remove_particle_in(p);
-    
-        if ( ve->particles_in().empty() ) {
-          auto prem = ve->particles_out();
-          for ( auto po : prem )  vp->add_particle_out(po);
-          ge.remove_vertex(ve);
+
+        g.unlinkOut(vp, p);
+        g.unlinkIn(ve, p);
+
+        if ( g.ins[ve].size == 0 ) {
+          // Hand the decay products to the production vertex, dropping ve
+          StripGraph::splice(g.outs[vp], g.outs[ve], g.nextout, g.prevout);
+          g.parent[ve] = vp;
         }
-        else if ( vp->particles_out().empty() ) {
-          auto prem = vp->particles_in();
-          for ( auto pi : prem ) ve->add_particle_in(pi);
-          ge.remove_vertex(vp);
+        else if ( g.outs[vp].size == 0 ) {
+          // Hand the parents to the decay vertex, dropping vp
+          StripGraph::splice(g.ins[ve], g.ins[vp], g.nextin, g.previn);
+          g.parent[vp] = ve;
         }
-        ge.remove_particle(p);
+        g.removedp[p] = true;
+        ++nremoved;
       }
+      if ( nremoved == 0 ) return;
+
+      // New 1-based ids of the surviving particles and vertices
+      vector<int> newpid(np, 0), newvid(nv, 0);
+      HepMC3::GenEventData out;
+      out.event_number = data.event_number;
+      out.momentum_unit = data.momentum_unit;
+      out.length_unit = data.length_unit;
+      out.event_pos = data.event_pos;
+      out.weights = data.weights;
+      out.particles.reserve(np - nremoved);
+      for ( size_t p = 0; p < np; ++p ) {
+        if ( g.removedp[p] ) continue;
+        out.particles.push_back(data.particles[p]);
+        newpid[p] = out.particles.size();
+      }
+      for ( size_t v = 0; v < nv; ++v ) {
+        if ( g.find(v) != int(v) ) continue;
+        out.vertices.push_back(data.vertices[v]);
+        newvid[v] = -int(out.vertices.size());
+      }
+      out.links1.reserve(data.links1.size());
+      out.links2.reserve(data.links2.size());
+      for ( size_t v = 0; v < nv; ++v ) {
+        if ( newvid[v] == 0 ) continue;
+        for ( int p = g.ins[v].head; p >= 0; p = g.nextin[p] ) {
+          out.links1.push_back(newpid[p]);
+          out.links2.push_back(newvid[v]);
+        }
+        for ( int p = g.outs[v].head; p >= 0; p = g.nextout[p] ) {
+          out.links1.push_back(newvid[v]);
+          out.links2.push_back(newpid[p]);
+        }
+      }
+
+      // Attributes follow their objects, and go with them
+      for ( size_t i = 0; i < data.attribute_id.size(); ++i ) {
+        int id = data.attribute_id[i];
+        if ( id > 0 ) id = newpid[id-1];
+        else if ( id < 0 ) id = newvid[-id-1];
+        if ( id == 0 && data.attribute_id[i] != 0 ) continue;
+        out.attribute_id.push_back(id);
+        out.attribute_name.push_back(data.attribute_name[i]);
+        out.attribute_string.push_back(data.attribute_string[i]);
+      }
+
+      ge.read_data(out);
     }
 
     pair<double,double> crossSection(const GenEvent & ge) {
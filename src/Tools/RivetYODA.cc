@@ -12,6 +12,7 @@
 
 // #include <regex>
 #include <sstream>
+#include <fstream>
 
 using namespace std;
 
@@ -28,15 +29,11 @@ Wrapper<T>::Wrapper(const vector<string>& weightNames, const T & p)
   _basePath = p.path();
   for (const string& weightname : weightNames) {
     _persistent.push_back(make_shared<T>(p));
-    _final.push_back(make_shared<T>(p));
 
     auto obj = _persistent.back();
     obj->setPath("/RAW" + obj->path());
-    auto final = _final.back();
-    if (weightname != "") {
+    if (weightname != "")
       obj->setPath(obj->path() + "[" + weightname + "]");
-      final->setPath(final->path() + "[" + weightname + "]");
-    }
   }
 }
 
@@ -55,13 +52,32 @@ typename T::Ptr Wrapper<T>::active() const {
 }
 
 
+template <class T>
+shared_ptr<MultiweightAOWrapper> Wrapper<T>::mkThreadReplica() {
+  if ( !_locks ) _locks = make_shared<WeightShardLocks>(_persistent.size());
+  auto rtn = make_shared<Wrapper<T>>();
+  rtn->_persistent = _persistent;
+  rtn->_locks = _locks;
+  rtn->_basePath = _basePath;
+  rtn->_replica = true;
+  // Take the binning now, while nothing is filling the shared objects
+  rtn->_evgroup.push_back( make_shared<TupleWrapper<T>>(_persistent[0]->clone()) );
+  return rtn;
+}
+
 template <class T>
 void Wrapper<T>::newSubEvent() {
-  typename TupleWrapper<T>::Ptr tmp
-      = make_shared<TupleWrapper<T>>(_persistent[0]->clone());
+  if ( _nsubevents == _evgroup.size() ) {
+    // Clone the binning from our own buffers if possible, not from the
+    // persistent objects, which may be shared with other threads
+    if ( _evgroup.empty() )
+      _evgroup.push_back( make_shared<TupleWrapper<T>>(_persistent[0]->clone()) );
+    else
+      _evgroup.push_back( make_shared<TupleWrapper<T>>(static_cast<const T&>(*_evgroup[0])) );
+  }
+  typename TupleWrapper<T>::Ptr tmp = _evgroup[_nsubevents++];
   tmp->reset();
-  _evgroup.push_back( tmp );
-  _active = _evgroup.back();
+  _active = tmp;
   assert(_active);
 }
 
@@ -78,18 +94,119 @@ void Wrapper<T>::newSubEvent() {
   }
 
 
+  namespace {
+
+    /// @brief A YODA reference data file held in memory
+    ///
+    /// The text block of each object is indexed by its histogram ID, so that
+    /// only the objects actually requested need to be run through the parser.
+    struct RefDataFile {
+      string text;
+      map<string, pair<size_t, size_t> > blocks;
+      map<string, YODA::AnalysisObjectPtr> objects;
+    };
+
+
+    /// Strip an optional leading comment marker from a YODA block delimiter line
+    string _stripHash(const string& line) {
+      const size_t first = line.find_first_not_of("# \t");
+      return first == string::npos ? "" : line.substr(first);
+    }
+
+
+    /// Get the indexed (but not parsed) contents of a ref data file, read once per process
+    RefDataFile& _refDataFile(const string& datafile) {
+      static map<string, RefDataFile> cache;
+      const auto ic = cache.find(datafile);
+      if (ic != cache.end()) return ic->second;
+
+      RefDataFile& rf = cache[datafile];
+      std::ifstream in(datafile.c_str(), std::ios::binary);
+      if (!in) throw Rivet::Error("Couldn't open ref data file '" + datafile + "'");
+      rf.text.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+
+      // Find the BEGIN ... END delimited block of each object
+      size_t pos = 0, begin = string::npos;
+      string plotname;
+      while (pos < rf.text.size()) {
+        size_t eol = rf.text.find('\n', pos);
+        if (eol == string::npos) eol = rf.text.size();
+        const string line = _stripHash(rf.text.substr(pos, eol-pos));
+        if (line.compare(0, 11, "BEGIN YODA_") == 0) {
+          // Split path at "/" and only keep the last field, i.e. the histogram ID
+          std::istringstream words(line);
+          string begintag, aotype, plotpath;
+          words >> begintag >> aotype >> plotpath;
+          const size_t slashpos = plotpath.rfind("/");
+          plotname = (slashpos+1 < plotpath.size()) ? plotpath.substr(slashpos+1) : "";
+          begin = pos;
+        } else if (begin != string::npos && line.compare(0, 9, "END YODA_") == 0) {
+          rf.blocks[plotname] = make_pair(begin, eol+1-begin);
+          begin = string::npos;
+        }
+        pos = eol + 1;
+      }
+      return rf;
+    }
+
+
+    /// Parse a single indexed object from a ref data file, on first request only
+    YODA::AnalysisObjectPtr _refDataObject(RefDataFile& rf, const string& hname) {
+      const auto io = rf.objects.find(hname);
+      if (io != rf.objects.end()) return io->second;
+
+      YODA::AnalysisObjectPtr rtn;
+      const auto ib = rf.blocks.find(hname);
+      if (ib != rf.blocks.end()) {
+        std::istringstream block(rf.text.substr(ib->second.first, ib->second.second));
+        vector<YODA::AnalysisObject*> aovec;
+        YODA::ReaderYODA::create().read(block, aovec);
+        for (size_t i = 0; i < aovec.size(); ++i) {
+          if (i == 0) rtn.reset(aovec[i]);
+          else delete aovec[i];
+        }
+      }
+      rf.objects[hname] = rtn;
+      return rtn;
+    }
+
+  }
+
+
+  YODA::AnalysisObjectPtr getRefDataObject(const string& papername, const string& hname) {
+    const string datafile = getDatafilePath(papername);
+    /// @todo Remove AIDA support some day...
+    if (datafile.find(".yoda") == string::npos) {
+      const map<string, YODA::AnalysisObjectPtr> refdata = getRefData(papername);
+      const auto ir = refdata.find(hname);
+      return ir != refdata.end() ? ir->second : nullptr;
+    }
+    return _refDataObject(_refDataFile(datafile), hname);
+  }
+
+
   map<string, YODA::AnalysisObjectPtr> getRefData(const string& papername) {
     const string datafile = getDatafilePath(papername);
 
+    // Return value, to be populated
+    map<string, YODA::AnalysisObjectPtr> rtn;
+
+    // YODA files go via the process-wide cache, returning copies since callers may modify them
+    if (datafile.find(".yoda") != string::npos) {
+      RefDataFile& rf = _refDataFile(datafile);
+      for (const auto& b : rf.blocks) {
+        YODA::AnalysisObjectPtr refdata = _refDataObject(rf, b.first);
+        if (refdata) rtn[b.first] = YODA::AnalysisObjectPtr(refdata->newclone());
+      }
+      return rtn;
+    }
+
     // Make an appropriate data file reader and read the data objects
     /// @todo Remove AIDA support some day...
-    YODA::Reader& reader = (datafile.find(".yoda") != string::npos) ?   \
-      YODA::ReaderYODA::create() : YODA::ReaderAIDA::create();
+    YODA::Reader& reader = YODA::ReaderAIDA::create();
     vector<YODA::AnalysisObject *> aovec;
     reader.read(datafile, aovec);
 
-    // Return value, to be populated
-    map<string, YODA::AnalysisObjectPtr> rtn;
     for ( YODA::AnalysisObject* ao : aovec ) {
       YODA::AnalysisObjectPtr refdata(ao);
       if (!refdata) continue;
@@ -163,16 +280,24 @@ namespace {
 
 
 
+  /// A windowed fill resulting from matched sub-events: position,
+  /// per-weight sum of weights and fill fraction
+  using WindowFill = std::tuple<double,valarray<double>,double>;
+
   template <class T>
   void commit(vector<typename T::Ptr> & persistent,
               const vector< vector<Fill<T>> > & tuple,
-              const vector<valarray<double>> & weights ) {
+              const vector<valarray<double>> & weights,
+              Rivet::WeightShardLocks * locks ) {
 
     // TODO check if all the xs are in the same bin anyway!
     // Then no windowing needed
 
     assert(persistent.size() == weights[0].size());
 
+    // The fills are worked out first, touching only the (fixed) binning,
+    // so that only their application needs the persistent objects locked
+    vector<WindowFill> hfill;
     for ( const auto & x : tuple ) {
       double maxwindow = 0.0;
       for ( const auto & xi : x ) {
@@ -192,7 +317,7 @@ namespace {
         edgeset.insert(fillT2binT<T>(xi.first) + wsize);
       }
 
-          vector< std::tuple<double,valarray<double>,double> > hfill;
+          const size_t nfirst = hfill.size();
           double sumf = 0.0;
           auto edgit = edgeset.begin();
           double ehi = *edgit;
@@ -214,27 +339,34 @@ namespace {
             hfill.push_back( make_tuple( (ehi + elo)/2.0, sumw, (ehi - elo) ) );
             sumf += ehi - elo;
           }
-
-          for ( auto f : hfill )
-            for ( size_t m = 0; m < persistent.size(); ++m )
-              persistent[m]->fill( get<0>(f), get<1>(f)[m], get<2>(f)/sumf );
-            // Note the scaling to one single fill
+          // Note the scaling to one single fill
+          for ( size_t i = nfirst; i < hfill.size(); ++i )
+            get<2>(hfill[i]) /= sumf;
 
     }
 
-  }
+    auto apply = [&](size_t mlo, size_t mhi) {
+      for ( const auto & f : hfill )
+        for ( size_t m = mlo; m < mhi; ++m )
+          persistent[m]->fill( get<0>(f), get<1>(f)[m], get<2>(f) );
+    };
+    if ( locks ) locks->forEachShard(apply);
+    else apply(0, persistent.size());
 
+  }
 
   template<>
   void commit<YODA::Histo2D>(vector<YODA::Histo2D::Ptr> & persistent,
               const vector< vector<Fill<YODA::Histo2D>> > & tuple,
-              const vector<valarray<double>> & weights)
+              const vector<valarray<double>> & weights,
+              Rivet::WeightShardLocks * locks)
   {}
 
   template<>
   void commit<YODA::Profile2D>(vector<YODA::Profile2D::Ptr> & persistent,
               const vector< vector<Fill<YODA::Profile2D>> > & tuple,
-              const vector<valarray<double>> & weights)
+              const vector<valarray<double>> & weights,
+              Rivet::WeightShardLocks * locks)
   {}
 
     template <class T>
@@ -280,25 +412,27 @@ namespace {
 
 namespace {
 
-/// fills is a vector of sub-event with an ordered set of x-values of
-/// the fills in each sub-event. NOFILL should be an "impossible"
+/// evgroup is a vector of sub-events, of which the first nsubevents are
+/// used, with the x-values of the fills in each sub-event. NOFILL should be an "impossible"
 /// value for this histogram. Returns a vector of sub-events with
 /// an ordered vector of fills (including NOFILLs) for each sub-event.
 template <class T>
 vector< vector<Fill<T> > >
-match_fills(const vector<typename TupleWrapper<T>::Ptr> & evgroup, const Fill<T> & NOFILL)
+match_fills(const vector<typename TupleWrapper<T>::Ptr> & evgroup, size_t nsubevents,
+            const Fill<T> & NOFILL)
 {
   vector< vector<Fill<T> > > matched;
-  // First just copy subevents into vectors and find the longest vector.
+  // First just copy subevents into sorted vectors and find the longest vector.
   unsigned int maxfill = 0; // length of biggest vector
   int imax = 0; // index position of biggest vector
-  for ( const auto & it : evgroup ) {
-    const auto & subev = it->fills();
+  for ( size_t n = 0; n < nsubevents; ++n ) {
+    const auto & subev = evgroup[n]->fills();
     if ( subev.size() > maxfill ) {
       maxfill = subev.size();
       imax = matched.size();
     }
     matched.push_back(vector<Fill<T> >(subev.begin(), subev.end()));
+    std::sort(matched.back().begin(), matched.back().end());
   }
   // Now, go through all subevents with missing fills.
   const vector<Fill<T>> & full = matched[imax]; // the longest one
@@ -343,34 +477,53 @@ namespace Rivet {
 
   template <class T>
   void Wrapper<T>::pushToPersistent(const vector<valarray<double> >& weight) {
-      assert( _evgroup.size() == weight.size() );
+      assert( _nsubevents == weight.size() );
 
       // have we had subevents at all?
-      const bool have_subevents = _evgroup.size() > 1;
+      const bool have_subevents = _nsubevents > 1;
       if ( ! have_subevents ) {
 
           // simple replay of all tuple entries
           // each recorded fill is inserted into all persistent weightname histos
-          for ( const auto & f : _evgroup[0]->fills() ) {
-              for ( size_t m = 0; m < _persistent.size(); ++m ) { //< m is the variation index
+          auto replay = [&](size_t mlo, size_t mhi) {
+            for ( size_t m = mlo; m < mhi; ++m ) { //< m is the variation index
+              for ( const auto & f : _evgroup[0]->fills() ) {
                   _persistent[m]->fill( f.first, f.second * weight[0][m] );
               }
-          }
+            }
+          };
+          if ( _locks ) _locks->forEachShard(replay);
+          else replay(0, _persistent.size());
 
       } else {
 
         // outer index is subevent, inner index is jets in the event
         vector<vector<Fill<T>>> linedUpXs
-            = match_fills<T>(_evgroup, {typename T::FillType(), 0.0});
-        commit<T>( _persistent, linedUpXs, weight );
+            = match_fills<T>(_evgroup, _nsubevents, {typename T::FillType(), 0.0});
+        commit<T>( _persistent, linedUpXs, weight, _locks.get() );
 
       }
-      _evgroup.clear();
+      _nsubevents = 0;
       _active.reset();
   }
 
+  template <class T>
+  size_t Wrapper<T>::numFills() const {
+    size_t nfills = 0;
+    for ( size_t n = 0; n < _nsubevents; ++n ) nfills += _evgroup[n]->fills().size();
+    return nfills;
+  }
+
   template <class T>
   void Wrapper<T>::pushToFinal() {
+    // Not thread-safe: _final is owned by the original wrapper only
+    assert(!_replica && "Thread replicas have no final objects");
+    // The finalized objects are only created when first needed, so
+    // booking makes one copy per weight instead of two.
+    if ( _final.size() != _persistent.size() ) {
+      _final.clear();
+      for ( const auto & p : _persistent ) _final.push_back(make_shared<T>(*p));
+    }
     for ( size_t m = 0; m < _persistent.size(); ++m ) {
       copyao(_persistent.at(m), _final.at(m));
       if ( _final[m]->path().substr(0,4) == "/RAW" )
@@ -382,36 +535,49 @@ namespace Rivet {
 
   template <>
   void Wrapper<YODA::Counter>::pushToPersistent(const vector<valarray<double> >& weight) {
-    for ( size_t n = 0; n < _evgroup.size(); ++n ) {
-      for ( const auto & f : _evgroup[n]->fills() ) {
-        for ( size_t m = 0; m < _persistent.size(); ++m ) {
-          _persistent[m]->fill( f.second * weight[n][m] );
+    auto replay = [&](size_t mlo, size_t mhi) {
+      for ( size_t m = mlo; m < mhi; ++m ) {
+        for ( size_t n = 0; n < _nsubevents; ++n ) {
+          for ( const auto & f : _evgroup[n]->fills() ) {
+            _persistent[m]->fill( f.second * weight[n][m] );
+          }
         }
       }
-    }
+    };
+    if ( _locks ) _locks->forEachShard(replay);
+    else replay(0, _persistent.size());
 
-    _evgroup.clear();
+    _nsubevents = 0;
     _active.reset();
   }
 
+  template <>
+  size_t Wrapper<YODA::Scatter1D>::numFills() const { return 0; }
+
+  template <>
+  size_t Wrapper<YODA::Scatter2D>::numFills() const { return 0; }
+
+  template <>
+  size_t Wrapper<YODA::Scatter3D>::numFills() const { return 0; }
+
   template <>
   void Wrapper<YODA::Scatter1D>::pushToPersistent(const vector<valarray<double> >& weight) {
 
-    _evgroup.clear();
+    _nsubevents = 0;
     _active.reset();
   }
 
   template <>
   void Wrapper<YODA::Scatter2D>::pushToPersistent(const vector<valarray<double> >& weight) {
 
-    _evgroup.clear();
+    _nsubevents = 0;
     _active.reset();
   }
 
   template <>
   void Wrapper<YODA::Scatter3D>::pushToPersistent(const vector<valarray<double> >& weight) {
 
-    _evgroup.clear();
+    _nsubevents = 0;
     _active.reset();
   }
 
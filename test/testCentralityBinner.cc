@@ -0,0 +1,99 @@
+#include "Rivet/Tools/CentralityBinner.hh"
+#include <iostream>
+#include <random>
+
+using namespace std;
+using namespace Rivet;
+
+
+// A binned object which just records its fills, so that the true
+// percentile of every event ending up in it can be checked afterwards
+struct Tally {
+  vector<pair<double,double> > fills;
+};
+typedef shared_ptr<Tally> TallyPtr;
+
+namespace Rivet {
+  template <>
+  struct CentralityBinTraits<TallyPtr> {
+    static TallyPtr clone(const TallyPtr & t) { return make_shared<Tally>(*t); }
+    static void add(TallyPtr & t, const TallyPtr & o) {
+      t->fills.insert(t->fills.end(), o->fills.begin(), o->fills.end());
+    }
+    static void scale(TallyPtr & t, double f) { for ( auto & x : t->fills ) x.second *= f; }
+    static void normalize(TallyPtr &, double) {}
+    static string path(const TallyPtr &) { return "/TEST/tally"; }
+  };
+}
+
+
+int main() {
+  const double eps = 0.005;
+  const int maxbins = 200, nevents = 100000;
+  const double edges[] = {0, 5, 10, 20, 30, 40, 50, 60, 70, 80, 90, 100};
+  const size_t nbins = 11;
+
+  CentralityBinner<TallyPtr> binner(maxbins, 1.0);
+  binner.setSketch(eps);
+  vector<TallyPtr> tallies;
+  for ( size_t i = 0; i < nbins; ++i ) {
+    tallies.push_back(make_shared<Tally>());
+    binner.add(tallies.back(), edges[i], edges[i+1]);
+  }
+
+  // Exponentially distributed estimator values
+  mt19937 rng(2718);
+  exponential_distribution<double> expo(1.0);
+  vector<double> cests;
+  for ( int i = 0; i < nevents; ++i ) {
+    const double cest = expo(rng);
+    cests.push_back(cest);
+    binner.select(cest)->fills.push_back(make_pair(cest, 1.0));
+    if ( (int)binner.allObjects().size() > maxbins ) {
+      cerr << "More than " << maxbins << " sketch bins after " << i+1 << " events" << endl;
+      return 1;
+    }
+  }
+  binner.finalize();
+  sort(cests.begin(), cests.end());
+  auto rank = [&](double cest) {
+    return double(lower_bound(cests.begin(), cests.end(), cest) - cests.begin())/nevents;
+  };
+
+  // The estimator edges must be at the requested ranks within epsilon
+  for ( const auto & e : binner.edges() ) {
+    if ( e.first <= 0.0 || e.first >= 1.0 ) continue;
+    if ( fabs(rank(e.second) - (1.0 - e.first)) > eps ) {
+      cerr << "Edge at " << 100*e.first << "%: estimator " << e.second << " has rank "
+           << rank(e.second) << ", expected " << 1.0 - e.first << endl;
+      return 1;
+    }
+  }
+
+  // Every event must have ended up in one of the centrality classes
+  double sumw = 0.0;
+  for ( const TallyPtr & t : tallies )
+    for ( const auto & f : t->fills ) sumw += f.second;
+  if ( fabs(sumw - nevents) > 1e-6*nevents ) {
+    cerr << "Centrality classes hold a weight of " << sumw << " for " << nevents << " events" << endl;
+    return 1;
+  }
+
+  // Only the bins straddling the two edges, of at most epsilon each,
+  // may bring in events from outside a centrality class
+  for ( size_t i = 0; i < nbins; ++i ) {
+    const double qlo = 1.0 - edges[i+1]/100.0, qhi = 1.0 - edges[i]/100.0;
+    double outside = 0.0;
+    for ( const auto & f : tallies[i]->fills ) {
+      const double q = rank(f.first);
+      if ( q < qlo || q >= qhi ) outside += f.second;
+    }
+    if ( outside/nevents > eps ) {
+      cerr << "Centrality " << edges[i] << "-" << edges[i+1] << "%: a fraction "
+           << outside/nevents << " of events from other centralities" << endl;
+      return 1;
+    }
+  }
+
+  return 0;
+}
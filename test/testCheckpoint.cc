@@ -0,0 +1,77 @@
+#include "Rivet/AnalysisHandler.hh"
+#include "Rivet/Tools/RivetHepMC.hh"
+#include "YODA/IO.h"
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+using namespace Rivet;
+
+
+// Run the analyses over the input events [first, last), resuming from
+// the checkpoint @a resume and writing one to @a checkpoint, if given.
+void run(AnalysisHandler & ah, const string & hepmcfile, size_t first, size_t last,
+         const string & resume = "", const string & checkpoint = "") {
+  ah.addAnalyses({"EXAMPLE", "MC_JETS"});
+  if ( !resume.empty() && ah.readCheckpoint(resume) != first )
+    throw UserError("Checkpoint at the wrong input event");
+  shared_ptr<std::istream> file;
+  shared_ptr<HepMC_IO_type> reader = HepMCUtils::makeReader(hepmcfile, file);
+  std::shared_ptr<GenEvent> evt = make_shared<GenEvent>();
+  for ( size_t i = 0; i < last && HepMCUtils::readEvent(reader, evt); ++i )
+    if ( i >= first ) ah.analyze(*evt);
+  if ( !checkpoint.empty() ) ah.writeCheckpoint(checkpoint, last);
+}
+
+
+// All raw and final objects of a run at full precision
+string dump(const AnalysisHandler & ah) {
+  vector<YODA::AnalysisObjectPtr> aos;
+  for ( auto rao : ah.getRivetAOs() ) {
+    for ( size_t iW = 0; iW < ah.numWeights(); ++iW ) {
+      rao.get()->setActiveWeightIdx(iW);
+      aos.push_back(rao.get()->activeYODAPtr());
+      rao.get()->setActiveFinalWeightIdx(iW);
+      aos.push_back(rao.get()->activeYODAPtr());
+    }
+    rao.get()->unsetActiveWeight();
+  }
+  std::ostringstream os;
+  YODA::Writer & writer = YODA::mkWriter("yoda");
+  writer.setPrecision(17);
+  writer.write(os, aos.begin(), aos.end());
+  return os.str();
+}
+
+
+int main(int argc, char* argv[]) {
+  assert(argc > 1);
+  const size_t nevents = 10, split = 4;
+
+  AnalysisHandler full;
+  run(full, argv[1], 0, nevents);
+  full.setCrossSection(make_pair(1.0, 0.1));
+  full.finalize();
+
+  // The same run, interrupted after the split'th event
+  {
+    AnalysisHandler before;
+    run(before, argv[1], 0, split, "", "testCheckpoint.ckp");
+  }
+  AnalysisHandler resumed;
+  run(resumed, argv[1], split, nevents, "testCheckpoint.ckp");
+  resumed.setCrossSection(make_pair(1.0, 0.1));
+  resumed.finalize();
+
+  if ( full.numEvents() != nevents || resumed.numEvents() != nevents ) {
+    cerr << "Runs saw " << full.numEvents() << " and " << resumed.numEvents()
+         << " events, expected " << nevents << endl;
+    return 1;
+  }
+  if ( dump(resumed) != dump(full) ) {
+    cerr << "The resumed run differs from the uninterrupted one" << endl;
+    return 1;
+  }
+
+  return 0;
+}
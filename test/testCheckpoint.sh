@@ -0,0 +1,2 @@
+#!/bin/bash
+exec ./testCheckpoint "$srcdir/testApi.hepmc"
@@ -0,0 +1,83 @@
+#include "Rivet/Tools/RivetHepMC.hh"
+#include "Rivet/Tools/WriterCompressedAscii.hh"
+#include "Rivet/Tools/ReaderCompressedAscii.hh"
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+using namespace Rivet;
+
+
+// The id of vertex @a v, or 0 if there is none
+int vid(HepMC3::ConstGenVertexPtr v) {
+  return v ? v->id() : 0;
+}
+
+
+// Compare the particles and their production and decay vertices of two events
+bool sameTopology(const GenEvent& in, const GenEvent& out) {
+  if ( in.particles().size() != out.particles().size() ||
+       in.vertices().size() != out.vertices().size() ) {
+    cerr << "Event " << in.event_number() << ": read back "
+         << out.particles().size() << " particles and " << out.vertices().size()
+         << " vertices, expected " << in.particles().size() << " and "
+         << in.vertices().size() << endl;
+    return false;
+  }
+  for ( size_t i = 0; i < in.particles().size(); ++i ) {
+    HepMC3::ConstGenParticlePtr pi = in.particles()[i], po = out.particles()[i];
+    if ( pi->pid() != po->pid() || pi->status() != po->status() ||
+         vid(pi->production_vertex()) != vid(po->production_vertex()) ||
+         vid(pi->end_vertex()) != vid(po->end_vertex()) ) {
+      cerr << "Event " << in.event_number() << ": particle " << pi->id()
+           << " read back as " << po->pid() << " (status " << po->status() << ", "
+           << vid(po->production_vertex()) << " -> " << vid(po->end_vertex())
+           << "), expected " << pi->pid() << " (status " << pi->status() << ", "
+           << vid(pi->production_vertex()) << " -> " << vid(pi->end_vertex()) << ")" << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+
+int main(int argc, char* argv[]) {
+  if ( argc < 2 ) {
+    cerr << "Usage: testCompressedAscii <file.hepmc>" << endl;
+    return 1;
+  }
+
+  vector<shared_ptr<GenEvent>> events;
+  shared_ptr<std::istream> file;
+  shared_ptr<HepMC_IO_type> reader = HepMCUtils::makeReader(argv[1], file);
+  shared_ptr<GenEvent> evt = make_shared<GenEvent>();
+  while ( HepMCUtils::readEvent(reader, evt) ) {
+    events.push_back(evt);
+    evt = make_shared<GenEvent>();
+  }
+  if ( events.empty() ) {
+    cerr << "No events in " << argv[1] << endl;
+    return 1;
+  }
+
+  // Round trip with both momentum encodings
+  for ( bool integers : { false, true } ) {
+    stringstream buffer;
+    {
+      WriterCompressedAscii writer(buffer);
+      if ( integers ) writer.use_integers();
+      for ( auto e : events ) writer.write_event(*e);
+    }
+    ReaderCompressedAscii compressed(buffer);
+    for ( auto e : events ) {
+      GenEvent back;
+      if ( !compressed.read_event(back) || !sameTopology(*e, back) ) {
+        cerr << "Round trip failed using " << (integers? "integer": "double")
+             << " momenta" << endl;
+        return 1;
+      }
+    }
+  }
+
+  return 0;
+}
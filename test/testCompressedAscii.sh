@@ -0,0 +1,2 @@
+#!/bin/bash
+exec ./testCompressedAscii "$srcdir/testApi.hepmc"
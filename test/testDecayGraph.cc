@@ -0,0 +1,138 @@
+#include "Rivet/Event.hh"
+#include "Rivet/Projections/UnstableParticles.hh"
+#include "Rivet/Projections/HeavyHadrons.hh"
+#include "Rivet/Projections/PrimaryHadrons.hh"
+#include "Rivet/Tools/RivetHepMC.hh"
+#include <iostream>
+
+using namespace std;
+using namespace Rivet;
+
+typedef vector<ConstGenParticlePtr> GenParticles;
+
+
+// The UnstableParticles selection, walking the children of each particle
+GenParticles refUnstables(const GenEvent* ge) {
+  GenParticles rtn;
+  for (ConstGenParticlePtr p : HepMCUtils::particles(ge)) {
+    const int st = p->status();
+    const PdgId apid = abs(p->pdg_id());
+    bool passed = (st == 1 || (st == 2 && apid != 22 && apid != 110 && apid != 990 && apid != 9990)) &&
+      !PID::isParton(p->pdg_id()) && st != 4;
+    ConstGenVertexPtr dv = p->end_vertex();
+    if (passed && dv) {
+      for (ConstGenParticlePtr c : HepMCUtils::particles(dv, Relatives::CHILDREN))
+        if (c->pdg_id() == p->pdg_id() && c->status() == 2) passed = false;
+    }
+    if (passed) rtn.push_back(p);
+  }
+  return rtn;
+}
+
+
+// The HeavyHadrons selection, walking the children of each unstable heavy hadron
+GenParticles refHeavyHadrons(const GenParticles& unstables) {
+  GenParticles rtn;
+  for (ConstGenParticlePtr p : unstables) {
+    const PdgId pid = p->pdg_id();
+    if (!PID::isHadron(pid) || (!PID::hasBottom(pid) && !PID::hasCharm(pid))) continue;
+    bool passed = true;
+    if (p->end_vertex()) {
+      for (ConstGenParticlePtr c : HepMCUtils::particles(p->end_vertex(), Relatives::CHILDREN)) {
+        if (PID::hasBottom(pid) ? PID::hasBottom(c->pdg_id()) : PID::hasCharm(c->pdg_id())) passed = false;
+      }
+    }
+    if (passed) rtn.push_back(p);
+  }
+  return rtn;
+}
+
+
+// The PrimaryHadrons selection, walking all the ancestors of each unstable hadron
+GenParticles refPrimaryHadrons(const GenParticles& unstables) {
+  GenParticles rtn;
+  for (ConstGenParticlePtr p : unstables) {
+    if (!PID::isHadron(p->pdg_id())) continue;
+    bool passed = true;
+    if (p->production_vertex()) {
+      for (ConstGenParticlePtr a : HepMCUtils::particles(p, Relatives::ANCESTORS)) {
+        if (a->status() == 2 && (PID::isHadron(a->pdg_id()) || abs(a->pdg_id()) == PID::TAU)) passed = false;
+      }
+    }
+    if (passed) rtn.push_back(p);
+  }
+  return rtn;
+}
+
+
+// Run projection @a p on event @a e
+template <typename PROJ>
+const PROJ& apply(const Event& e, PROJ& p) {
+  Projection& proj = p;
+  return pcast<PROJ>(e.applyProjection(proj));
+}
+
+
+// Compare a projection's selection with the reference one
+bool same(const string& name, const Particles& ps, const GenParticles& ref) {
+  bool rtn = ps.size() == ref.size();
+  for (size_t i = 0; rtn && i < ps.size(); ++i) rtn = ps[i].genParticle() == ref[i];
+  if (!rtn) {
+    cerr << name << ": selected";
+    for (const Particle& p : ps) cerr << " " << HepMCUtils::uniqueId(p.genParticle());
+    cerr << ", expected";
+    for (ConstGenParticlePtr p : ref) cerr << " " << HepMCUtils::uniqueId(p);
+    cerr << endl;
+  }
+  return rtn;
+}
+
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    cerr << "Usage: testDecayGraph <file.hepmc> ..." << endl;
+    return 1;
+  }
+
+  UnstableParticles ufs;
+  HeavyHadrons hhs;
+  PrimaryHadrons phs;
+
+  size_t nevt = 0, nheavy = 0, nprimary = 0;
+  for (int i = 1; i < argc; ++i) {
+    shared_ptr<std::istream> file;
+    shared_ptr<HepMC_IO_type> reader = HepMCUtils::makeReader(argv[i], file);
+    std::shared_ptr<GenEvent> evt = make_shared<GenEvent>();
+    while (HepMCUtils::readEvent(reader, evt)) {
+      ++nevt;
+      const Event e(*evt);
+      const GenParticles unstables = refUnstables(e.genEvent());
+      const GenParticles heavies = refHeavyHadrons(unstables);
+      const GenParticles primaries = refPrimaryHadrons(unstables);
+
+      GenParticles bs, cs;
+      for (ConstGenParticlePtr p : heavies) (PID::hasBottom(p->pdg_id()) ? bs : cs).push_back(p);
+
+      const HeavyHadrons& hh = apply(e, hhs);
+      const bool ok =
+        same("UnstableParticles", apply(e, ufs).particles(), unstables) &&
+        same("HeavyHadrons", hh.particles(), heavies) &&
+        same("HeavyHadrons b", hh.bHadrons(), bs) &&
+        same("HeavyHadrons c", hh.cHadrons(), cs) &&
+        same("PrimaryHadrons", apply(e, phs).particles(), primaries);
+      if (!ok) {
+        cerr << "Selections differ in event " << nevt << " of " << argv[i] << endl;
+        return 1;
+      }
+      nheavy += heavies.size();
+      nprimary += primaries.size();
+    }
+  }
+
+  // Make sure the sample actually exercises the decay chains
+  if (nheavy == 0 || nprimary == 0) {
+    cerr << "No heavy or primary hadrons in " << nevt << " events" << endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,2 @@
+#!/bin/bash
+exec ./testDecayGraph "$srcdir/testDecayGraph.hepmc" "$srcdir/testApi.hepmc"
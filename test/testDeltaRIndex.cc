@@ -0,0 +1,109 @@
+#include "Rivet/Particle.hh"
+#include <iostream>
+#include <random>
+
+using namespace std;
+using namespace Rivet;
+
+
+// Random particles, a quarter of them just above phi = 0 and a quarter just below 2 pi
+Particles randomParticles(mt19937& rng, size_t n) {
+  uniform_real_distribution<double> flat(0.0, 1.0);
+  Particles rtn;
+  for (size_t i = 0; i < n; ++i) {
+    double phi = TWOPI*flat(rng);
+    if (i % 4 == 0) phi = 1e-3*flat(rng);
+    else if (i % 4 == 1) phi = TWOPI - 1e-3*flat(rng);
+    const double eta = 5*flat(rng) - 2.5, pt = 1 + 50*flat(rng);
+    rtn.push_back(Particle(PID::PIPLUS, FourMomentum::mkEtaPhiMPt(eta, phi, 0.14, pt)));
+  }
+  return rtn;
+}
+
+
+// Positions of the particles within dR of c, by brute force
+vector<size_t> bruteWithin(const Particles& ps, const Particle& c, double dR, RapScheme scheme) {
+  vector<size_t> rtn;
+  for (size_t i = 0; i < ps.size(); ++i)
+    if (deltaR(c.mom(), ps[i].mom(), scheme) < dR) rtn.push_back(i);
+  return rtn;
+}
+
+
+int main() {
+  mt19937 rng(4711);
+  const double dRs[] = {0.05, 0.4, 1.0, 3.0, PI, 3.5, 6.0};
+  const RapScheme schemes[] = {PSEUDORAPIDITY, RAPIDITY};
+
+  for (size_t itrial = 0; itrial < 50; ++itrial) {
+    const Particles parts = randomParticles(rng, 1 + rng() % 200);
+    const Particles centres = randomParticles(rng, 1 + rng() % 10);
+
+    for (RapScheme scheme : schemes) {
+      const DeltaRIndex idx(parts, scheme);
+      if (idx.size() != parts.size()) {
+        cerr << "Index has " << idx.size() << " entries for " << parts.size() << " particles" << endl;
+        return 1;
+      }
+      for (double dR : dRs) {
+        for (const Particle& c : centres) {
+          const vector<size_t> expected = bruteWithin(parts, c, dR, scheme);
+          if (idx.within(c, dR) != expected) {
+            cerr << "within(" << dR << ") differs from brute force around " << c.mom() << endl;
+            return 1;
+          }
+          if (idx.anyWithin(c, dR) != !expected.empty()) {
+            cerr << "anyWithin(" << dR << ") differs from brute force around " << c.mom() << endl;
+            return 1;
+          }
+          double sumpt = 0;
+          for (size_t i : expected) sumpt += parts[i].pT();
+          if (!fuzzyEquals(idx.sumPt(c, dR), sumpt, 1e-10)) {
+            cerr << "sumPt(" << dR << ") = " << idx.sumPt(c, dR) << ", expected " << sumpt << endl;
+            return 1;
+          }
+        }
+      }
+    }
+
+    for (double dR : dRs) {
+      // Cone sums with the default pseudorapidity scheme
+      const vector<double> conepts = coneSumPts(centres, parts, dR);
+      const vector<double> idxpts = DeltaRIndex(parts).sumPts(centres, dR);
+      const vector<bool> anys = DeltaRIndex(parts).anyWithin(centres, dR);
+      for (size_t j = 0; j < centres.size(); ++j) {
+        double sumpt = 0;
+        for (size_t i : bruteWithin(parts, centres[j], dR, PSEUDORAPIDITY)) sumpt += parts[i].pT();
+        if (!fuzzyEquals(conepts[j], sumpt, 1e-10) || !fuzzyEquals(idxpts[j], sumpt, 1e-10)) {
+          cerr << "Cone sum " << conepts[j] << " / " << idxpts[j] << ", expected " << sumpt << endl;
+          return 1;
+        }
+        if (anys[j] != (sumpt > 0)) {
+          cerr << "anyWithin(centres, " << dR << ") differs from brute force" << endl;
+          return 1;
+        }
+      }
+
+      // Overlap removal of the centres against the particles
+      Particles expected;
+      for (const Particle& c : centres)
+        if (bruteWithin(parts, c, dR, PSEUDORAPIDITY).empty()) expected.push_back(c);
+      Particles kept = centres;
+      idiscardIfAnyDeltaRLess(kept, parts, dR);
+      const Particles kept2 = discardIfAnyDeltaRLess(centres, parts, dR);
+      if (kept.size() != expected.size() || kept2.size() != expected.size()) {
+        cerr << "idiscardIfAnyDeltaRLess(" << dR << ") kept " << kept.size()
+             << " particles, expected " << expected.size() << endl;
+        return 1;
+      }
+      for (size_t j = 0; j < kept.size(); ++j) {
+        if (kept[j].mom() != expected[j].mom() || kept2[j].mom() != expected[j].mom()) {
+          cerr << "idiscardIfAnyDeltaRLess(" << dR << ") kept the wrong particles" << endl;
+          return 1;
+        }
+      }
+    }
+  }
+
+  return 0;
+}
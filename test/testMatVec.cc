@@ -1,11 +1,13 @@
 #include "Rivet/Math/MathUtils.hh"
 #include "Rivet/Math/Vectors.hh"
 #include "Rivet/Math/Matrices.hh"
+#include "Rivet/Math/MomentumTensor.hh"
 // #include "Rivet/Math/MatrixDiag.hh"
 using namespace Rivet;
 
 #include <iostream>
 #include <limits>
+#include <random>
 #include <cassert>
 using namespace std;
 
@@ -23,8 +25,80 @@ LorentzTransform mkLTz(const double beta) {
 }
 
 
+/// Check the closed-form symmetric eigensystem against Eigen's self-adjoint solver
+void checkSymEigen(const SymMatrix3& m) {
+  Eigen::Matrix3d em;
+  em << m[0], m[3], m[4],
+        m[3], m[1], m[5],
+        m[4], m[5], m[2];
+  const Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> es(em);
+  const double scale = max(1.0, es.eigenvalues().cwiseAbs().maxCoeff());
+
+  // Eigenvalues, in descending order (Eigen's are ascending)
+  double ls[3];
+  symEigenvalues(m, ls[0], ls[1], ls[2]);
+  assert(ls[0] >= ls[1] && ls[1] >= ls[2]);
+  for (size_t i = 0; i < 3; ++i) {
+    assert(fabs(ls[i] - es.eigenvalues()[2-i]) < 1e-12*scale);
+  }
+
+  for (size_t i = 0; i < 3; ++i) {
+    const Vector3 ev = symEigenvector(m, ls[i]);
+    // Unit length, non-negative z, and a genuine eigenvector
+    assert(fuzzyEquals(ev.mod(), 1.0, 1e-12));
+    assert(ev.z() >= 0);
+    const Eigen::Vector3d v(ev.x(), ev.y(), ev.z());
+    assert((em*v - ls[i]*v).norm() < 1e-6*scale);
+    // Parallel to Eigen's vector when the eigenvalue is well separated
+    const double gap = min(i > 0 ? ls[i-1] - ls[i] : HUGE_VAL, i < 2 ? ls[i] - ls[i+1] : HUGE_VAL);
+    if (gap > 1e-3*scale) {
+      const Eigen::Vector3d ref = es.eigenvectors().col(2-i);
+      assert(fuzzyEquals(fabs(ref.dot(v)), 1.0, 1e-8));
+    }
+  }
+}
+
+
 int main() {
 
+  cout << "Symmetric eigensystems:" << endl;
+  {
+    // Diagonal, with the orientation convention on a negative-z axis
+    checkSymEigen({{3, 2, 1, 0, 0, 0}});
+    assert(fuzzyEquals(symEigenvector({{3, 2, 1, 0, 0, 0}}, 1), Vector3(0, 0, 1)));
+    checkSymEigen({{0.5, 0.3, 0.2, 0.1, -0.05, 0.02}});
+    // Degenerate: fully, exactly l1 == l2, and nearly so
+    checkSymEigen({{1, 1, 1, 0, 0, 0}});
+    checkSymEigen({{2, 2, 1, 0, 0, 0}});
+    checkSymEigen({{2, 1, 1, 1, 1, 1}});
+    checkSymEigen({{2, 2 + 1e-9, 1, 1e-10, 0, 0}});
+    // Rank 1 and rank 2, from one and two momenta
+    const Vector3 p(1, -2, -3), q(0.5, 4, -1);
+    checkSymEigen({{p.x()*p.x(), p.y()*p.y(), p.z()*p.z(), p.x()*p.y(), p.x()*p.z(), p.y()*p.z()}});
+    const Vector3 ev1 = symEigenvector({{p.x()*p.x(), p.y()*p.y(), p.z()*p.z(),
+                                         p.x()*p.y(), p.x()*p.z(), p.y()*p.z()}}, p.mod2());
+    assert(fuzzyEquals(ev1, -p.unit()));
+    checkSymEigen({{p.x()*p.x() + q.x()*q.x(), p.y()*p.y() + q.y()*q.y(), p.z()*p.z() + q.z()*q.z(),
+                    p.x()*p.y() + q.x()*q.y(), p.x()*p.z() + q.x()*q.z(), p.y()*p.z() + q.y()*q.z()}});
+    // Null matrix
+    checkSymEigen({{0, 0, 0, 0, 0, 0}});
+
+    // Random momentum tensors from the packed kernel
+    mt19937 rng(31415);
+    normal_distribution<double> gaus(0, 10);
+    for (size_t i = 0; i < 500; ++i) {
+      PackedMomenta pm;
+      const size_t n = 1 + rng() % 20;
+      for (size_t j = 0; j < n; ++j) pm.push_back(gaus(rng), gaus(rng), gaus(rng));
+      const MomentumTensors t = pm.tensors(i % 2 ? 1.0 : 2.0);
+      SymMatrix3 mq = t.quad, ml = t.lin;
+      for (size_t k = 0; k < 6; ++k) { mq[k] /= t.quadNorm; ml[k] /= t.linNorm; }
+      checkSymEigen(mq);
+      checkSymEigen(ml);
+    }
+  }
+  cout << endl;
+
   FourVector a(1,0,0,0);
   cout << a << ": interval = " << a.invariant() << endl;
   assert(fuzzyEquals(a.invariant(), 1));
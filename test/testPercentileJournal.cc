@@ -0,0 +1,102 @@
+#include "Rivet/Tools/Percentile.hh"
+#include <iostream>
+#include <random>
+
+using namespace std;
+using namespace Rivet;
+
+
+const vector<pair<float, float> > CENT = { {0, 10}, {10, 30}, {30, 60}, {60, 100}, {0, 100} };
+
+
+/// What a journal replays: the active bins of each event and the fills
+struct Replayed {
+  vector<vector<int> > active;
+  vector<pair<vector<int>, double> > fills;
+};
+
+
+/// Journal the events [first, last) of a toy run, with one fill each
+void journal(PercentileJournal & j, const vector<double> & ests, const vector<double> & ws,
+             size_t first, size_t last) {
+  for ( size_t i = first; i < last; ++i ) {
+    j.beginEvent(i, valarray<double>{ws[i], 1.0}, ests[i]);
+    const double x = i;
+    j.addFill(&x, 1);
+  }
+}
+
+
+/// Calibrate a journal with the first weight and collect what it replays
+void replay(PercentileJournal & j, Replayed & r) {
+  j.setAnalysisObjects({}, [&r](const vector<int> & active) { r.active.push_back(active); });
+  j.setReplayer(1, [&r](const vector<int> & active, const double * x) {
+      r.fills.push_back(make_pair(active, x[0]));
+    });
+  j.replay(0);
+}
+
+
+int main() {
+  // A toy estimator, eg. a multiplicity, with large values for central events
+  const size_t nevents = 5000;
+  mt19937 rng(1234);
+  gamma_distribution<double> mult(2.0, 50.0);
+  uniform_real_distribution<double> weight(0.5, 1.5);
+  vector<double> ests, ws;
+  for ( size_t i = 0; i < nevents; ++i ) {
+    ests.push_back(mult(rng));
+    ws.push_back(weight(rng));
+  }
+
+  PercentileJournal full(CENT, false);
+  journal(full, ests, ws, 0, nevents);
+  if ( !full.recording() || full.percentile(ests[0]) >= 0.0 ) {
+    cerr << "Journal is calibrated before the replay" << endl;
+    return 1;
+  }
+  Replayed r;
+  replay(full, r);
+  if ( r.active.size() != nevents || r.fills.size() != nevents ) {
+    cerr << "Replayed " << r.active.size() << " events and " << r.fills.size()
+         << " fills, expected " << nevents << endl;
+    return 1;
+  }
+
+  // Brute-force percentiles: the weight of the more central events plus
+  // half the event's own weight
+  double sumw = 0.0;
+  for ( double w : ws ) sumw += w;
+  for ( size_t i = 0; i < nevents; ++i ) {
+    double above = 0.5*ws[i];
+    for ( size_t k = 0; k < nevents; ++k )
+      if ( ests[k] > ests[i] ) above += ws[k];
+    const double pcnt = 100.0*above/sumw;
+    if ( fabs(full.percentile(ests[i]) - pcnt) > 1e-9 ) {
+      cerr << "Estimator " << ests[i] << " has percentile " << full.percentile(ests[i])
+           << ", expected " << pcnt << endl;
+      return 1;
+    }
+    vector<int> active;
+    for ( size_t b = 0; b < CENT.size(); ++b )
+      if ( PercentileBase::inRange(full.percentile(ests[i]), CENT[b]) ) active.push_back(b);
+    if ( r.active[i] != active || r.fills[i].first != active || r.fills[i].second != i ) {
+      cerr << "Event " << i << " was replayed into the wrong centrality bins" << endl;
+      return 1;
+    }
+  }
+
+  // A journal spilled half-way and continued in a new one replays the same
+  PercentileJournal first(CENT, false), second(CENT, false);
+  journal(first, ests, ws, 0, nevents/2);
+  second.restore(first.spill());
+  journal(second, ests, ws, nevents/2, nevents);
+  Replayed r2;
+  replay(second, r2);
+  if ( r2.active != r.active || r2.fills != r.fills ) {
+    cerr << "Journal restored from a spill replays differently" << endl;
+    return 1;
+  }
+
+  return 0;
+}
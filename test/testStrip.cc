@@ -0,0 +1,162 @@
+#include "Rivet/Tools/RivetHepMC.hh"
+#include <iostream>
+#include <random>
+
+#ifdef RIVET_ENABLE_HEPMC_3
+
+#include "HepMC3/Attribute.h"
+
+using namespace std;
+using namespace HepMC3;
+
+
+// The original particle-by-particle stripping, as reference
+void stripReference(GenEvent& ge, const set<long>& stripid) {
+  vector<GenParticlePtr> allparticles = ge.particles();
+  for ( auto & p : allparticles ) {
+    if ( !p->production_vertex() || !p->end_vertex() ||
+         stripid.count(p->pid()) == 0 ||
+         p->production_vertex()->id() == 0  ) continue;
+    GenVertexPtr vp = p->production_vertex();
+    GenVertexPtr ve = p->end_vertex();
+    if ( vp == ve ) continue;
+    if ( ( vp->particles_out().size() == 1 && vp->particles_out()[0] == p ) ||
+         ( ve->particles_in().size() == 1 && ve->particles_in()[0] == p ) ) {
+      bool loop = false;
+      for ( auto pi : vp->particles_in() )
+        for ( auto po : ve->particles_out() )
+          if ( pi == po ) loop = true;
+      if ( loop ) continue;
+    }
+    if ( vp->particles_in().size() == 1 &&
+         ( vp->particles_in()[0]->pid() > 21 &&
+           vp->particles_in()[0]->pid() < 30 ) )
+      continue;
+    vp->remove_particle_out(p);
+    ve->remove_particle_in(p);
+    if ( ve->particles_in().empty() ) {
+      auto prem = ve->particles_out();
+      for ( auto po : prem )  vp->add_particle_out(po);
+      ge.remove_vertex(ve);
+    }
+    else if ( vp->particles_out().empty() ) {
+      auto prem = vp->particles_in();
+      for ( auto pi : prem ) ve->add_particle_in(pi);
+      ge.remove_vertex(vp);
+    }
+    ge.remove_particle(p);
+  }
+}
+
+
+// A shower-like event: partons branching, a Z decay and hadronisation clusters
+void buildEvent(GenEvent& ge, unsigned int seed) {
+  mt19937 rng(seed);
+  uniform_real_distribution<double> flat(0.0, 1.0);
+  auto mkp = [&](int pid, int status) {
+    return make_shared<GenParticle>(FourVector(flat(rng), flat(rng), flat(rng), 10*flat(rng)+1), pid, status);
+  };
+  const int quarks[] = {1, -1, 2, -2, 3, -3, 21, 21};
+
+  GenParticlePtr b1 = mkp(2212, 4), b2 = mkp(2212, 4);
+  ge.add_particle(b1);
+  ge.add_particle(b2);
+  GenVertexPtr hard = make_shared<GenVertex>();
+  hard->add_particle_in(b1);
+  hard->add_particle_in(b2);
+  ge.add_vertex(hard);
+
+  vector<GenParticlePtr> open;
+  for ( int i = 0; i < 4; ++i ) {
+    GenParticlePtr p = mkp(quarks[rng() % 8], 2);
+    hard->add_particle_out(p);
+    open.push_back(p);
+  }
+  GenParticlePtr z = mkp(23, 2);
+  hard->add_particle_out(z);
+  GenVertexPtr zdec = make_shared<GenVertex>();
+  zdec->add_particle_in(z);
+  ge.add_vertex(zdec);
+  for ( int i = 0; i < 2; ++i ) {
+    GenParticlePtr q = mkp(i ? -1 : 1, 2);
+    zdec->add_particle_out(q);
+    open.push_back(q);
+  }
+
+  // Parton branchings, some 1 -> 1 recoils, and multi-parton clusters
+  vector<GenParticlePtr> hadrons;
+  while ( !open.empty() ) {
+    const size_t ntake = open.size() > 2 && flat(rng) < 0.2 ? 2 : 1;
+    GenVertexPtr v = make_shared<GenVertex>();
+    for ( size_t i = 0; i < ntake; ++i ) {
+      const size_t j = rng() % open.size();
+      v->add_particle_in(open[j]);
+      open.erase(open.begin() + j);
+    }
+    ge.add_vertex(v);
+    const size_t nout = 1 + rng() % 3;
+    const bool cluster = flat(rng) < 0.3 || ge.particles().size() > 300;
+    for ( size_t i = 0; i < nout; ++i ) {
+      GenParticlePtr p = cluster ? mkp(211, 1) : mkp(quarks[rng() % 8], 2);
+      v->add_particle_out(p);
+      (cluster ? hadrons : open).push_back(p);
+    }
+    if ( flat(rng) < 0.3 ) v->add_attribute("tag", make_shared<IntAttribute>(int(rng() % 100)));
+  }
+  for ( const auto& p : ge.particles() )
+    if ( flat(rng) < 0.1 ) p->add_attribute("tag", make_shared<IntAttribute>(int(rng() % 100)));
+}
+
+
+// Compare topology, particle properties and attributes of two events
+bool sameEvent(const GenEvent& a, const GenEvent& b) {
+  if ( a.particles().size() != b.particles().size() ) return false;
+  if ( a.vertices().size() != b.vertices().size() ) return false;
+  for ( size_t i = 0; i < a.particles().size(); ++i ) {
+    ConstGenParticlePtr pa = a.particles()[i], pb = b.particles()[i];
+    if ( pa->pid() != pb->pid() || pa->status() != pb->status() ) return false;
+    if ( pa->momentum() != pb->momentum() ) return false;
+    auto ta = pa->attribute<IntAttribute>("tag"), tb = pb->attribute<IntAttribute>("tag");
+    if ( bool(ta) != bool(tb) || ( ta && ta->value() != tb->value() ) ) return false;
+  }
+  for ( size_t i = 0; i < a.vertices().size(); ++i ) {
+    ConstGenVertexPtr va = a.vertices()[i], vb = b.vertices()[i];
+    if ( va->particles_in().size() != vb->particles_in().size() ||
+         va->particles_out().size() != vb->particles_out().size() ) return false;
+    for ( size_t j = 0; j < va->particles_in().size(); ++j )
+      if ( va->particles_in()[j]->id() != vb->particles_in()[j]->id() ) return false;
+    for ( size_t j = 0; j < va->particles_out().size(); ++j )
+      if ( va->particles_out()[j]->id() != vb->particles_out()[j]->id() ) return false;
+    auto ta = va->attribute<IntAttribute>("tag"), tb = vb->attribute<IntAttribute>("tag");
+    if ( bool(ta) != bool(tb) || ( ta && ta->value() != tb->value() ) ) return false;
+  }
+  return true;
+}
+
+
+int main() {
+  const set<long> stripid = {1, -1, 2, -2, 3, -3, 21};
+  for ( unsigned int seed = 1; seed <= 200; ++seed ) {
+    GenEvent ref, fast;
+    buildEvent(ref, seed);
+    buildEvent(fast, seed);
+    const size_t nbefore = ref.particles().size();
+    stripReference(ref, stripid);
+    Rivet::HepMCUtils::strip(fast, stripid);
+    if ( !sameEvent(ref, fast) ) {
+      cerr << "Stripped event " << seed << " differs from reference: "
+           << fast.particles().size() << " particles, expected "
+           << ref.particles().size() << " (from " << nbefore << ")" << endl;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+#else
+
+int main() {
+  return 0;
+}
+
+#endif
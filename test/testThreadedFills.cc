@@ -0,0 +1,86 @@
+#include "Rivet/Tools/RivetYODA.hh"
+#include <iostream>
+#include <thread>
+
+using namespace std;
+using namespace Rivet;
+
+
+// Several threads commit events through their own replicas into one shared
+// multi-weight store. All fills and weights are small integers, so the sums
+// are exact whatever order the commits happen in.
+
+const size_t NWEIGHTS = 37, NTHREADS = 8, NEVENTS = 2000;
+
+
+void runThread(size_t ithread, shared_ptr<MultiweightAOWrapper> h, shared_ptr<MultiweightAOWrapper> c) {
+  for (size_t iev = 0; iev < NEVENTS; ++iev) {
+    // Every fourth event has two sub-events filling the same position
+    const size_t nsub = iev % 4 == 0 ? 2 : 1;
+    vector<valarray<double> > weights(nsub, valarray<double>(NWEIGHTS));
+    for (size_t n = 0; n < nsub; ++n) {
+      for (size_t m = 0; m < NWEIGHTS; ++m) weights[n][m] = m + 1 + n;
+      h->newSubEvent();
+      c->newSubEvent();
+      const double x = (iev + ithread) % 10 + 0.5;
+      dynamic_pointer_cast<YODA::Histo1D>(h->activeYODAPtr())->fill(x, 1 + iev % 3);
+      dynamic_pointer_cast<YODA::Counter>(c->activeYODAPtr())->fill(2);
+    }
+    h->pushToPersistent(weights);
+    c->pushToPersistent(weights);
+  }
+}
+
+
+int main() {
+  vector<string> weightnames(1, "");
+  for (size_t m = 1; m < NWEIGHTS; ++m) weightnames.push_back("W" + to_string(m));
+  Wrapper<YODA::Histo1D> h(weightnames, YODA::Histo1D(10, 0.0, 10.0, "/TEST/h"));
+  Wrapper<YODA::Counter> c(weightnames, YODA::Counter("/TEST/c"));
+
+  vector<shared_ptr<MultiweightAOWrapper> > hreps, creps;
+  for (size_t t = 0; t < NTHREADS; ++t) {
+    hreps.push_back(h.mkThreadReplica());
+    creps.push_back(c.mkThreadReplica());
+  }
+  vector<thread> threads;
+  for (size_t t = 0; t < NTHREADS; ++t)
+    threads.push_back(thread(runThread, t, hreps[t], creps[t]));
+  for (thread& t : threads) t.join();
+
+  // The same sums, single-threaded
+  for (size_t m = 0; m < NWEIGHTS; ++m) {
+    double sumw = 0, csumw = 0;
+    vector<double> binsumw(10, 0.0);
+    for (size_t t = 0; t < NTHREADS; ++t) {
+      for (size_t iev = 0; iev < NEVENTS; ++iev) {
+        const size_t nsub = iev % 4 == 0 ? 2 : 1;
+        for (size_t n = 0; n < nsub; ++n) {
+          const double w = (1 + iev % 3) * double(m + 1 + n);
+          sumw += w;
+          binsumw[(iev + t) % 10] += w;
+          csumw += 2 * double(m + 1 + n);
+        }
+      }
+    }
+    const YODA::Histo1D* hm = h._getPersistent(m);
+    if (hm->sumW() != sumw) {
+      cerr << "Weight " << m << ": histogram sum of weights " << hm->sumW() << ", expected " << sumw << endl;
+      return 1;
+    }
+    for (size_t i = 0; i < 10; ++i) {
+      if (hm->bin(i).sumW() != binsumw[i]) {
+        cerr << "Weight " << m << ", bin " << i << ": sum of weights "
+             << hm->bin(i).sumW() << ", expected " << binsumw[i] << endl;
+        return 1;
+      }
+    }
+    if (c._getPersistent(m)->sumW() != csumw) {
+      cerr << "Weight " << m << ": counter sum of weights " << c._getPersistent(m)->sumW()
+           << ", expected " << csumw << endl;
+      return 1;
+    }
+  }
+
+  return 0;
+}